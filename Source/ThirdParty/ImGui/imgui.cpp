@@ -842,6 +842,9 @@ static void             SetCurrentWindow(ImGuiWindow* window);
 static void             FindHoveredWindow();
 static ImGuiWindow*     CreateNewWindow(const char* name, ImGuiWindowFlags flags);
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window);
+static ImGuiID          CalcWindowRetainedHash(ImGuiWindow* window);
+static void             RecordWindowRetainedDrawList(ImGuiWindow* window);
+static void             RestoreWindowRetainedDrawList(ImGuiWindow* window);
 
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
@@ -1060,6 +1063,7 @@ ImGuiIO::ImGuiIO()
     ClipboardUserData = NULL;
     ImeSetInputScreenPosFn = ImeSetInputScreenPosFn_DefaultImpl;
     ImeWindowHandle = NULL;
+    TessellationParallelFor = NULL; // [UnrealImGui]
 
     // Input (NB: we already have memset zero the entire structure!)
     MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
@@ -2612,6 +2616,162 @@ const char* ImGui::FindRenderedTextEnd(const char* text, const char* text_end)
     return text_display_end;
 }
 
+// [UnrealImGui] Text cache
+// Labels drawn with the same text, font and size replay their glyph quads instead of laying the text out again
+#define IMGUI_TEXT_CACHE_MAX_LENGTH     256     // Longer text isn't cached
+#define IMGUI_TEXT_CACHE_MAX_AGE        120     // Frames an entry is kept without being drawn
+
+static bool TextCacheLayoutFits(const ImGuiTextCacheEntry* entry, const ImVec2& aligned_pos, const ImVec4& clip_rect)
+{
+    return aligned_pos.x + entry->LayoutMin.x >= clip_rect.x && aligned_pos.y + entry->LayoutMin.y >= clip_rect.y
+        && aligned_pos.x + entry->LayoutMax.x <= clip_rect.z && aligned_pos.y + entry->LayoutMax.y <= clip_rect.w;
+}
+
+// ImDrawList::AddText() without fine clipping, through the text cache
+static void AddTextCached(ImDrawList* draw_list, const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text, const char* text_end, float wrap_width = 0.0f)
+{
+    ImGuiContext& g = *GImGui;
+    const int text_length = (int)(text_end - text);
+    if (!g.TextCacheEnabled || (col & IM_COL32_A_MASK) == 0 || text_length == 0 || text_length > IMGUI_TEXT_CACHE_MAX_LENGTH)
+    {
+        draw_list->AddText(font, font_size, pos, col, text, text_end, wrap_width);
+        return;
+    }
+    if (font == NULL)
+        font = draw_list->_Data->Font;
+    if (font_size == 0.0f)
+        font_size = draw_list->_Data->FontSize;
+
+    const float params[2] = { font_size, wrap_width };
+    const ImGuiID key = ImHashData(text, (size_t)text_length, ImHashData(params, sizeof(params), ImHashData(&font, sizeof(font))));
+    ImGuiTextCacheEntry* entry = g.TextCache.GetOrAddByKey(key);
+    if (entry->Font != font || entry->FontSize != font_size || entry->WrapWidth != wrap_width || entry->FontGlyphsGeneration != font->GlyphsGeneration
+        || entry->Text.Size != text_length || memcmp(entry->Text.Data, text, (size_t)text_length) != 0)
+    {
+        entry->Font = font;
+        entry->FontSize = font_size;
+        entry->WrapWidth = wrap_width;
+        entry->FontGlyphsGeneration = font->GlyphsGeneration;
+        entry->Text.resize(text_length);
+        memcpy(entry->Text.Data, text, (size_t)text_length);
+        entry->SeenBefore = entry->Recorded = false;
+        entry->Vertices.resize(0);
+        entry->GlyphIndices.resize(0);
+    }
+    entry->LastFrameUsed = g.FrameCount;
+
+    // Same pixel alignment as ImFont::RenderText()
+    const ImVec2 aligned_pos(IM_FLOOR(pos.x), IM_FLOOR(pos.y));
+    const ImVec4& clip_rect = draw_list->_CmdHeader.ClipRect;
+    if (entry->Recorded && TextCacheLayoutFits(entry, aligned_pos, clip_rect))
+    {
+        IM_ASSERT(font->ContainerAtlas->TexID == draw_list->_CmdHeader.TextureId);
+        const int vtx_count = entry->Vertices.Size;
+        if (vtx_count > 0)
+        {
+            draw_list->PrimReserve((vtx_count / 4) * 6, vtx_count);
+            ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+            ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+            unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+            for (const ImDrawVert* vtx_read = entry->Vertices.Data; vtx_read < entry->Vertices.Data + vtx_count; vtx_read += 4)
+            {
+                idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                for (int n = 0; n < 4; n++)
+                {
+                    vtx_write[n].pos.x = aligned_pos.x + vtx_read[n].pos.x;
+                    vtx_write[n].pos.y = aligned_pos.y + vtx_read[n].pos.y;
+                    vtx_write[n].uv = vtx_read[n].uv;
+                    vtx_write[n].col = col;
+                }
+                vtx_write += 4;
+                vtx_current_idx += 4;
+                idx_write += 6;
+            }
+            draw_list->_VtxWritePtr = vtx_write;
+            draw_list->_IdxWritePtr = idx_write;
+            draw_list->_VtxCurrentIdx = vtx_current_idx;
+        }
+
+        // Keep the glyphs resident, as FindGlyph() would have
+        for (int n = 0; n < entry->GlyphIndices.Size; n++)
+            font->StampGlyphUsed(entry->GlyphIndices.Data[n]);
+        g.TextCacheHits++;
+        return;
+    }
+
+    g.TextCacheMisses++;
+    const int vtx_begin = draw_list->VtxBuffer.Size;
+    draw_list->AddText(font, font_size, pos, col, text, text_end, wrap_width);
+    if (entry->Recorded)
+        return;
+    if (!entry->SeenBefore)
+    {
+        entry->SeenBefore = true;
+        return;
+    }
+
+    // Only record what was laid out without any culling
+    const ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_end);
+    ImVec2 layout_min(0.0f, 0.0f);
+    ImVec2 layout_max(text_size.x, text_size.y);
+    for (int n = vtx_begin; n < draw_list->VtxBuffer.Size; n++)
+    {
+        const ImVec2 rel_pos(draw_list->VtxBuffer.Data[n].pos.x - aligned_pos.x, draw_list->VtxBuffer.Data[n].pos.y - aligned_pos.y);
+        layout_min = ImMin(layout_min, rel_pos);
+        layout_max = ImMax(layout_max, rel_pos);
+    }
+    entry->LayoutMin = layout_min;
+    entry->LayoutMax = layout_max;
+    if (!TextCacheLayoutFits(entry, aligned_pos, clip_rect) || font->GlyphsGeneration != entry->FontGlyphsGeneration)
+        return;
+
+    entry->Vertices.resize(draw_list->VtxBuffer.Size - vtx_begin);
+    for (int n = 0; n < entry->Vertices.Size; n++)
+    {
+        const ImDrawVert& vtx = draw_list->VtxBuffer.Data[vtx_begin + n];
+        entry->Vertices.Data[n].pos = ImVec2(vtx.pos.x - aligned_pos.x, vtx.pos.y - aligned_pos.y);
+        entry->Vertices.Data[n].uv = vtx.uv;
+        entry->Vertices.Data[n].col = 0;
+    }
+    if (font->GlyphsLastUsed.Size > 0)
+    {
+        for (const char* s = text; s < text_end; )
+        {
+            unsigned int c = (unsigned int)*s;
+            s += (c < 0x80) ? 1 : ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0)
+                break;
+            if (const ImFontGlyph* glyph = font->FindGlyphNoFallback((ImWchar)c))
+                if (glyph->Visible)
+                    entry->GlyphIndices.push_back((int)(glyph - font->Glyphs.Data));
+        }
+        if (font->FallbackGlyph != NULL)
+            entry->GlyphIndices.push_back((int)(font->FallbackGlyph - font->Glyphs.Data));
+    }
+    entry->Recorded = true;
+}
+
+// Drops entries that haven't been drawn for a while, and their keys
+static void TextCacheGarbageCollect(ImGuiContext& g)
+{
+    ImGuiStorage& map = g.TextCache.Map;
+    int live_count = 0;
+    for (int n = 0; n < map.Data.Size; n++)
+    {
+        ImGuiStorage::ImGuiStoragePair pair = map.Data[n];
+        if (pair.val_i == -1)
+            continue;
+        if (g.TextCache.GetByIndex(pair.val_i)->LastFrameUsed < g.FrameCount - IMGUI_TEXT_CACHE_MAX_AGE)
+        {
+            g.TextCache.Remove(pair.key, pair.val_i); // Sets map.Data[n].val_i to -1, without reordering
+            continue;
+        }
+        map.Data[live_count++] = pair; // Keeps the keys sorted
+    }
+    map.Data.resize(live_count);
+}
+
 // Internal ImGui functions to render text
 // RenderText***() functions calls ImDrawList::AddText() calls ImBitmapFont::RenderText()
 void ImGui::RenderText(ImVec2 pos, const char* text, const char* text_end, bool hide_text_after_hash)
@@ -2634,7 +2794,7 @@ void ImGui::RenderText(ImVec2 pos, const char* text, const char* text_end, bool
 
     if (text != text_display_end)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_display_end);
+        AddTextCached(window->DrawList, g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_display_end); // [UnrealImGui]
         if (g.LogEnabled)
             LogRenderedText(&pos, text, text_display_end);
     }
@@ -2650,7 +2810,7 @@ void ImGui::RenderTextWrapped(ImVec2 pos, const char* text, const char* text_end
 
     if (text != text_end)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        AddTextCached(window->DrawList, g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width); // [UnrealImGui]
         if (g.LogEnabled)
             LogRenderedText(&pos, text, text_end);
     }
@@ -2682,7 +2842,7 @@ void ImGui::RenderTextClippedEx(ImDrawList* draw_list, const ImVec2& pos_min, co
     }
     else
     {
-        draw_list->AddText(NULL, 0.0f, pos, GetColorU32(ImGuiCol_Text), text, text_display_end, 0.0f, NULL);
+        AddTextCached(draw_list, NULL, 0.0f, pos, GetColorU32(ImGuiCol_Text), text, text_display_end); // [UnrealImGui]
     }
 }
 
@@ -2986,6 +3146,11 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
+    window->RetainedHash = 0; // [UnrealImGui]
+    window->RetainedCmdBuffer.clear();
+    window->RetainedIdxBuffer.clear();
+    window->RetainedVtxBuffer.clear();
+    window->RetainedGlyphs.clear();
 }
 
 void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
@@ -3793,6 +3958,15 @@ void ImGui::NewFrame()
     g.WithinFrameScope = true;
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
+
+    // [UnrealImGui] Text cache
+    g.TextCacheHitsLastFrame = g.TextCacheHits;
+    g.TextCacheMissesLastFrame = g.TextCacheMisses;
+    g.TextCacheHits = g.TextCacheMisses = 0;
+    if (!g.TextCacheEnabled)
+        g.TextCache.Clear();
+    else if ((g.FrameCount % 60) == 0)
+        TextCacheGarbageCollect(g);
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
 
@@ -3805,6 +3979,17 @@ void ImGui::NewFrame()
     // Setup current font and draw list shared data
     g.IO.Fonts->Locked = true;
     SetCurrentFont(GetDefaultFont());
+
+    // [UnrealImGui] Anything that changes the look of every window invalidates all retained draw lists
+    ImGuiID retained_frame_hash = ImHashData(&g.Style, sizeof(g.Style));
+    retained_frame_hash = ImHashData(&g.IO.DisplaySize, sizeof(g.IO.DisplaySize), retained_frame_hash);
+    retained_frame_hash = ImHashData(&g.IO.FontGlobalScale, sizeof(g.IO.FontGlobalScale), retained_frame_hash);
+    retained_frame_hash = ImHashData(&g.IO.Fonts->TexID, sizeof(g.IO.Fonts->TexID), retained_frame_hash);
+    retained_frame_hash = ImHashData(&g.IO.BackendFlags, sizeof(g.IO.BackendFlags), retained_frame_hash);
+    for (int n = 0; n < g.IO.Fonts->Fonts.Size; n++)
+        retained_frame_hash = ImHashData(&g.IO.Fonts->Fonts[n]->GlyphsGeneration, sizeof(int), retained_frame_hash);
+    g.RetainedFrameHash = retained_frame_hash;
+    g.IO.Fonts->GlyphsUseLog = NULL; // Only set between Begin() and End() of a retained window
     IM_ASSERT(g.Font->IsLoaded());
     g.DrawListSharedData.ClipRectFullscreen = ImVec4(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
     g.DrawListSharedData.CurveTessellationTol = g.Style.CurveTessellationTol;
@@ -3818,14 +4003,20 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.Style.AntiAliasedLines && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasAnalyticAA)) // [UnrealImGui]
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesAnalytic;
 
     g.BackgroundDrawList._ResetForNewFrame();
     g.BackgroundDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.BackgroundDrawList.PushClipRectFullScreen();
+    if (g.IO.TessellationParallelFor) // [UnrealImGui] Tessellated by Render()
+        g.BackgroundDrawList.Flags |= ImDrawListFlags_DeferTessellation;
 
     g.ForegroundDrawList._ResetForNewFrame();
     g.ForegroundDrawList.PushTextureID(g.IO.Fonts->TexID);
     g.ForegroundDrawList.PushClipRectFullScreen();
+    if (g.IO.TessellationParallelFor)
+        g.ForegroundDrawList.Flags |= ImDrawListFlags_DeferTessellation;
 
     // Mark rendering data as invalid to prevent user who may have a handle on it to use it.
     g.DrawData.Clear();
@@ -4076,6 +4267,7 @@ void ImGui::Shutdown(ImGuiContext* context)
 
     g.Tables.Clear();
     g.CurrentTableStack.clear();
+    g.TextCache.Clear(); // [UnrealImGui]
     g.DrawChannelsTempMergeBuffer.clear();
 
     g.ClipboardHandlerData.clear();
@@ -4202,6 +4394,30 @@ void ImDrawDataBuilder::FlattenIntoSingleLayer()
     }
 }
 
+// [UnrealImGui]
+static void TessellateDeferredDrawListJob(void* job_data, int index)
+{
+    ImDrawList** draw_lists = (ImDrawList**)job_data;
+    draw_lists[index]->_TessellateDeferred();
+}
+
+// [UnrealImGui] Each draw list only writes into its own buffers, so they can all be tessellated at once
+static void TessellateDeferredDrawLists(ImVector<ImDrawList*>* draw_lists)
+{
+    ImGuiContext& g = *GImGui;
+    ImVector<ImDrawList*>& to_tessellate = g.DrawListsToTessellate;
+    to_tessellate.resize(0);
+    for (int n = 0; n < draw_lists->Size; n++)
+        if (draw_lists->Data[n]->_DeferredShapes.Size > 0)
+            to_tessellate.push_back(draw_lists->Data[n]);
+
+    if (to_tessellate.Size > 1 && g.IO.TessellationParallelFor)
+        g.IO.TessellationParallelFor(to_tessellate.Size, TessellateDeferredDrawListJob, to_tessellate.Data);
+    else
+        for (int n = 0; n < to_tessellate.Size; n++)
+            to_tessellate.Data[n]->_TessellateDeferred();
+}
+
 static void SetupDrawData(ImVector<ImDrawList*>* draw_lists, ImDrawData* draw_data)
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -4362,6 +4578,9 @@ void ImGui::Render()
     if (!g.ForegroundDrawList.VtxBuffer.empty())
         AddDrawListToDrawData(&g.DrawDataBuilder.Layers[0], &g.ForegroundDrawList);
 
+    // [UnrealImGui] Write the geometry of the shapes draw lists deferred
+    TessellateDeferredDrawLists(&g.DrawDataBuilder.Layers[0]);
+
     // Setup ImDrawData structure for end-user
     SetupDrawData(&g.DrawDataBuilder.Layers[0], &g.DrawData);
     g.IO.MetricsRenderVertices = g.DrawData.TotalVtxCount;
@@ -5667,6 +5886,10 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->ContentSizeExplicit = g.NextWindowData.ContentSizeVal;
     else if (first_begin_of_the_frame)
         window->ContentSizeExplicit = ImVec2(0.0f, 0.0f);
+    if (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasContentHash)
+        window->RetainedContentHash = g.NextWindowData.ContentHashVal;
+    else if (first_begin_of_the_frame)
+        window->RetainedContentHash = 0;
     if (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasCollapsed)
         SetWindowCollapsed(window, g.NextWindowData.CollapsedVal, g.NextWindowData.CollapsedCond);
     if (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasFocus)
@@ -5684,6 +5907,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
         window->DrawList->_ResetForNewFrame();
+        if (g.IO.TessellationParallelFor) // [UnrealImGui] Tessellated by Render()
+            window->DrawList->Flags |= ImDrawListFlags_DeferTessellation;
         window->DC.CurrentTableIdx = -1;
 
         // Restore buffer capacity when woken from a compacted state, to avoid
@@ -6129,6 +6354,14 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     {
         // Append
         SetCurrentWindow(window);
+
+        // [UnrealImGui] End() recorded the draw list of a retained window already, log the glyphs of what we append so the next End() records it all again
+        if ((flags & ImGuiWindowFlags_Retained) && !window->RetainedThisFrame && window->RetainedHash != 0)
+        {
+            IM_ASSERT(window->RetainedParentGlyphsUseLog == NULL);
+            window->RetainedParentGlyphsUseLog = g.IO.Fonts->GlyphsUseLog;
+            g.IO.Fonts->GlyphsUseLog = &window->RetainedGlyphs;
+        }
     }
 
     // Pull/inherit current state
@@ -6174,12 +6407,147 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         if (window->Collapsed || !window->Active || window->Hidden)
             if (window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && window->HiddenFramesCannotSkipItems <= 0)
                 skip_items = true;
+
+        // [UnrealImGui] Retained windows skip their contents while nothing they draw can have changed, End() restores the recorded draw list
+        window->RetainedThisFrame = false;
+        if (flags & ImGuiWindowFlags_Retained)
+        {
+            const ImGuiID retained_hash = skip_items ? 0 : CalcWindowRetainedHash(window);
+            if (retained_hash != 0 && retained_hash == window->RetainedHash)
+            {
+                window->RetainedThisFrame = true;
+                skip_items = true;
+                for (int n = 0; n < window->RetainedGlyphs.Size; n++)
+                    window->RetainedGlyphs[n].Font->StampGlyphUsed(window->RetainedGlyphs[n].GlyphIndex);
+            }
+            window->RetainedHash = retained_hash;
+
+            // End() records the draw list, log the glyphs it uses until then
+            if (!window->RetainedThisFrame && retained_hash != 0)
+            {
+                window->RetainedGlyphs.resize(0);
+                window->RetainedParentGlyphsUseLog = g.IO.Fonts->GlyphsUseLog;
+                g.IO.Fonts->GlyphsUseLog = &window->RetainedGlyphs;
+            }
+        }
         window->SkipItems = skip_items;
     }
 
     return !window->SkipItems;
 }
 
+// [UnrealImGui] Hash of everything the draw list of an ImGuiWindowFlags_Retained window depends on besides its contents, 0 while the window is interacted with
+static ImGuiID CalcWindowRetainedHash(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->Appearing || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0)
+        return 0;
+    if (g.HoveredWindow == window || (g.ActiveId != 0 && g.ActiveIdWindow == window) || g.MovingWindow == window)
+        return 0;
+    if ((g.NavWindow == window && !g.NavDisableHighlight) || g.NavMoveRequest || g.NavInitRequest || g.NavWindowingTarget != NULL)
+        return 0;
+    if (g.OpenPopupStack.Size > 0 || g.DragDropActive || g.LogEnabled)
+        return 0;
+
+    struct
+    {
+        ImGuiID             ContentHash;
+        ImGuiWindowFlags    Flags;
+        ImVec2              Pos, Size, Scroll, ContentSizeExplicit;
+        const ImFont*       Font;
+        float               FontSize;
+        bool                TitleBarHighlight;
+    } key;
+    memset(&key, 0, sizeof(key)); // Padding is hashed too
+    key.ContentHash = window->RetainedContentHash;
+    key.Flags = window->Flags;
+    key.Pos = window->Pos;
+    key.Size = window->Size;
+    key.Scroll = window->Scroll;
+    key.ContentSizeExplicit = window->ContentSizeExplicit;
+    key.Font = g.Font;
+    key.FontSize = g.FontSize;
+    key.TitleBarHighlight = (g.NavWindow && window->RootWindowForTitleBarHighlight == g.NavWindow->RootWindowForTitleBarHighlight);
+    const ImGuiID hash = ImHashStr(window->Name, 0, ImHashData(&key, sizeof(key), g.RetainedFrameHash));
+    return hash != 0 ? hash : 1;
+}
+
+static int IMGUI_CDECL FontGlyphRefComparer(const void* lhs, const void* rhs)
+{
+    const ImFontGlyphRef* a = (const ImFontGlyphRef*)lhs;
+    const ImFontGlyphRef* b = (const ImFontGlyphRef*)rhs;
+    if (a->Font != b->Font)
+        return (a->Font < b->Font) ? -1 : +1;
+    return a->GlyphIndex - b->GlyphIndex;
+}
+
+// Only called when Begin() logged the glyphs the window used into RetainedGlyphs.
+// Called again by every End() of a window appended to in the same frame, the last one wins.
+static void RecordWindowRetainedDrawList(ImGuiWindow* window)
+{
+    ImFontAtlas* atlas = GImGui->IO.Fonts;
+    IM_ASSERT(atlas->GlyphsUseLog == &window->RetainedGlyphs);
+    atlas->GlyphsUseLog = window->RetainedParentGlyphsUseLog;
+    window->RetainedParentGlyphsUseLog = NULL;
+
+    // Child windows draw into their own draw lists, which we would have to retain as well.
+    // Callback data may only be valid for this frame, e.g. UnrealImGui's primitive batches index into buffers refilled every frame.
+    // Checked on every recorded frame: clearing RetainedHash makes the next frame record again rather than replay.
+    ImDrawList* draw_list = window->DrawList;
+    bool unsupported = (window->DC.ChildWindows.Size > 0);
+    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size && !unsupported; cmd_n++)
+        if (draw_list->CmdBuffer.Data[cmd_n].UserCallback != NULL && draw_list->CmdBuffer.Data[cmd_n].UserCallback != ImDrawCallback_ResetRenderState)
+            unsupported = true;
+    if (unsupported)
+    {
+        window->RetainedHash = 0;
+        window->RetainedGlyphs.resize(0);
+        return;
+    }
+
+    draw_list->_TessellateDeferred();
+    window->RetainedCmdBuffer = draw_list->CmdBuffer;
+    window->RetainedIdxBuffer = draw_list->IdxBuffer;
+    window->RetainedVtxBuffer = draw_list->VtxBuffer;
+    window->RetainedCmdHeader = draw_list->_CmdHeader;
+    window->RetainedVtxCurrentIdx = draw_list->_VtxCurrentIdx;
+    window->RetainedCursorMaxPos = window->DC.CursorMaxPos;
+    window->RetainedIdealMaxPos = window->DC.IdealMaxPos;
+
+    // The log repeats glyphs drawn more than once
+    if (window->RetainedGlyphs.Size > 1)
+    {
+        ImQsort(window->RetainedGlyphs.Data, (size_t)window->RetainedGlyphs.Size, sizeof(ImFontGlyphRef), FontGlyphRefComparer);
+        int unique_count = 1;
+        for (int n = 1; n < window->RetainedGlyphs.Size; n++)
+        {
+            const ImFontGlyphRef& glyph = window->RetainedGlyphs.Data[n];
+            const ImFontGlyphRef& last = window->RetainedGlyphs.Data[unique_count - 1];
+            if (glyph.Font != last.Font || glyph.GlyphIndex != last.GlyphIndex)
+                window->RetainedGlyphs.Data[unique_count++] = glyph;
+        }
+        window->RetainedGlyphs.resize(unique_count);
+    }
+}
+
+static void RestoreWindowRetainedDrawList(ImGuiWindow* window)
+{
+    // Replaces what Begin() drew this frame, the decorations are part of the recorded draw list
+    // Shapes it deferred would write into buffers that are gone, and the recorded ones were tessellated before being recorded
+    ImDrawList* draw_list = window->DrawList;
+    draw_list->_DeferredShapes.resize(0);
+    draw_list->_DeferredPoints.resize(0);
+    draw_list->CmdBuffer = window->RetainedCmdBuffer;
+    draw_list->IdxBuffer = window->RetainedIdxBuffer;
+    draw_list->VtxBuffer = window->RetainedVtxBuffer;
+    draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->_CmdHeader = window->RetainedCmdHeader;
+    draw_list->_VtxCurrentIdx = window->RetainedVtxCurrentIdx;
+    window->DC.CursorMaxPos = window->RetainedCursorMaxPos;
+    window->DC.IdealMaxPos = window->RetainedIdealMaxPos;
+}
+
 void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
@@ -6202,6 +6570,12 @@ void ImGui::End()
         EndColumns();
     PopClipRect();   // Inner window clip rectangle
 
+    // [UnrealImGui] Record or restore the draw list of retained windows
+    if (window->RetainedThisFrame)
+        RestoreWindowRetainedDrawList(window);
+    else if ((window->Flags & ImGuiWindowFlags_Retained) && window->RetainedHash != 0)
+        RecordWindowRetainedDrawList(window);
+
     // Stop logging
     if (!(window->Flags & ImGuiWindowFlags_ChildWindow))    // FIXME: add more options for scope of logging
         LogFinish();
@@ -6739,6 +7113,14 @@ void ImGui::SetNextWindowBgAlpha(float alpha)
     g.NextWindowData.BgAlphaVal = alpha;
 }
 
+// [UnrealImGui]
+void ImGui::SetNextWindowContentHash(ImGuiID hash)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextWindowData.Flags |= ImGuiNextWindowDataFlags_HasContentHash;
+    g.NextWindowData.ContentHashVal = hash;
+}
+
 ImDrawList* ImGui::GetWindowDrawList()
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -10713,6 +11095,19 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     }
 #endif // #ifdef IMGUI_HAS_TABLE
 
+    // [UnrealImGui] Details for the text cache
+    int text_cache_entries = 0;
+    for (int n = 0; n < g.TextCache.Map.Data.Size; n++)
+        if (g.TextCache.Map.Data[n].val_i != -1)
+            text_cache_entries++;
+    if (TreeNode("TextCache", "Text Cache (%d entries)", text_cache_entries))
+    {
+        Checkbox("Enabled", &g.TextCacheEnabled);
+        const int text_cache_lookups = g.TextCacheHitsLastFrame + g.TextCacheMissesLastFrame;
+        Text("Last frame: %d hits, %d misses (%.1f%% hit rate)", g.TextCacheHitsLastFrame, g.TextCacheMissesLastFrame, text_cache_lookups > 0 ? 100.0f * g.TextCacheHitsLastFrame / text_cache_lookups : 0.0f);
+        TreePop();
+    }
+
     // Details for Docking
 #ifdef IMGUI_HAS_DOCK
     if (TreeNode("Docking"))
@@ -10906,6 +11301,9 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, const ImDrawList* draw_list,
     if (!node_open)
         return;
 
+    // [UnrealImGui] Vertices are shown below, write those of deferred shapes now
+    const_cast<ImDrawList*>(draw_list)->_TessellateDeferred();
+
     if (window && !window->WasActive)
         TextDisabled("Warning: owning Window is inactive. This DrawList is not being rendered!");
 
@@ -11087,6 +11485,8 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
     BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    if (window->Flags & ImGuiWindowFlags_Retained)
+        BulletText("Retained: %d, RetainedHash: 0x%08X, %d vtx, %d glyphs", window->RetainedThisFrame, window->RetainedHash, window->RetainedVtxBuffer.Size, window->RetainedGlyphs.Size); // [UnrealImGui]
     BulletText("NavLastIds: 0x%08X,0x%08X, NavLayerActiveMask: %X", window->NavLastIds[0], window->NavLastIds[1], window->DC.NavLayerActiveMask);
     BulletText("NavLastChildNavWindow: %s", window->NavLastChildNavWindow ? window->NavLastChildNavWindow->Name : "NULL");
     if (!window->NavRectRel[0].IsInverted())
@@ -119,6 +119,7 @@ Index of this file:
 struct ImDrawChannel;               // Temporary storage to output draw commands out of order, used by ImDrawListSplitter and ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
+struct ImDrawDeferredShape;         // [UnrealImGui] A shape recorded by an ImDrawList, tessellated later by ImGui::Render()
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
@@ -189,6 +190,7 @@ typedef void* ImTextureID;          // User data for rendering backend to identi
 typedef unsigned int ImGuiID;       // A unique ID used by widgets, typically hashed from a stack of string.
 typedef int (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);    // Callback function for ImGui::InputText()
 typedef void (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);             // Callback function for ImGui::SetNextWindowSizeConstraints()
+typedef void (*ImGuiParallelFor)(int count, void (*job)(void* job_data, int index), void* job_data); // [UnrealImGui] Runs job(job_data, i) for every i in [0, count), possibly concurrently. Returns once all jobs are done.
 
 // Character types
 // (we generally use UTF-8 encoded string in the API. This is storage specifically for a decoded character used for keyboard input and display)
@@ -328,6 +330,7 @@ namespace ImGui
     IMGUI_API void          SetNextWindowCollapsed(bool collapsed, ImGuiCond cond = 0);                 // set next window collapsed state. call before Begin()
     IMGUI_API void          SetNextWindowFocus();                                                       // set next window to be focused / top-most. call before Begin()
     IMGUI_API void          SetNextWindowBgAlpha(float alpha);                                          // set next window background color alpha. helper to easily override the Alpha component of ImGuiCol_WindowBg/ChildBg/PopupBg. you may also use ImGuiWindowFlags_NoBackground.
+    IMGUI_API void          SetNextWindowContentHash(ImGuiID hash);                                     // [UnrealImGui] set next window content hash, e.g. a hash of the values it displays. An ImGuiWindowFlags_Retained window resubmits its contents whenever it changes.
     IMGUI_API void          SetWindowPos(const ImVec2& pos, ImGuiCond cond = 0);                        // (not recommended) set current window position - call within Begin()/End(). prefer using SetNextWindowPos(), as this may incur tearing and side-effects.
     IMGUI_API void          SetWindowSize(const ImVec2& size, ImGuiCond cond = 0);                      // (not recommended) set current window size - call within Begin()/End(). set to ImVec2(0, 0) to force an auto-fit. prefer using SetNextWindowSize(), as this may incur tearing and minor side-effects.
     IMGUI_API void          SetWindowCollapsed(bool collapsed, ImGuiCond cond = 0);                     // (not recommended) set current window collapsed state. prefer using SetNextWindowCollapsed().
@@ -886,6 +889,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_NoNavInputs            = 1 << 18,  // No gamepad/keyboard navigation within the window
     ImGuiWindowFlags_NoNavFocus             = 1 << 19,  // No focusing toward this window with gamepad/keyboard navigation (e.g. skipped by CTRL+TAB)
     ImGuiWindowFlags_UnsavedDocument        = 1 << 20,  // Append '*' to title without affecting the ID, as a convenience to avoid using the ### operator. When used in a tab/docking context, tab is selected on closure and closure is deferred by one frame to allow code to cancel the closure (with a confirmation popup, etc.) without flicker.
+    ImGuiWindowFlags_Retained               = 1 << 21,  // [UnrealImGui] Replay last frame's draw list instead of submitting contents while the window isn't interacted with and nothing it depends on changed: Begin() then returns false. Pass a hash of the displayed data with SetNextWindowContentHash(). Windows are resubmitted every frame while they have child windows or draw callbacks.
     ImGuiWindowFlags_NoNav                  = ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
     ImGuiWindowFlags_NoDecoration           = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse,
     ImGuiWindowFlags_NoInputs               = ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
@@ -1354,7 +1358,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasGamepad            = 1 << 0,   // Backend Platform supports gamepad and currently has one connected.
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
-    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3    // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasAnalyticAA = 1 << 4    // [UnrealImGui] Backend Renderer resolves the coverage of ImDrawListFlags_AntiAliasedLinesAnalytic strokes in its pixel shader.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -1777,6 +1782,10 @@ struct ImGuiIO
     void        (*ImeSetInputScreenPosFn)(int x, int y);
     void*       ImeWindowHandle;                // = NULL           // (Windows) Set this to your HWND to get automatic IME cursor positioning.
 
+    // [UnrealImGui] Optional: Defer the tessellation of strokes and convex fills to Render(), which runs one job per draw list through this function.
+    // Widgets then only record the shapes they draw (see ImDrawListFlags_DeferTessellation). Read by NewFrame() and Begin().
+    ImGuiParallelFor TessellationParallelFor;   // = NULL
+
     //------------------------------------------------------------------
     // Input - Fill before calling NewFrame()
     //------------------------------------------------------------------
@@ -2311,7 +2320,27 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLines        = 1 << 0,  // Enable anti-aliased lines/borders (*2 the number of triangles for 1.0f wide line or lines thin enough to be drawn using textures, otherwise *3 the number of triangles)
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering.
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
-    ImDrawListFlags_AllowVtxOffset          = 1 << 3   // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AntiAliasedLinesAnalytic = 1 << 4, // [UnrealImGui] Emit anti-aliased lines without fringe geometry, as 2 vertices per point whose UVs hold the distance to the line's center for the renderer to resolve coverage (see ImDrawList::AddPolyline). Set when 'ImGuiBackendFlags_RendererHasAnalyticAA' is enabled.
+    ImDrawListFlags_DeferTessellation       = 1 << 5   // [UnrealImGui] AddPolyline() and AddConvexPolyFilled() only reserve their geometry and record the shape, which _TessellateDeferred() writes later. Set on the draw lists Render() tessellates when 'io.TessellationParallelFor' is set.
+};
+
+// [UnrealImGui] A stroke or convex fill recorded by an ImDrawList with ImDrawListFlags_DeferTessellation, whose geometry is already reserved
+struct ImDrawDeferredShape
+{
+    int             PointsOffset;       // First point in ImDrawList::_DeferredPoints
+    int             PointsCount;
+    int             VtxOffset;          // Reserved vertices in VtxBuffer
+    int             VtxCount;
+    int             IdxOffset;          // Reserved indices in IdxBuffer
+    int             IdxCount;
+    unsigned int    VtxCurrentIdx;      // Index of the first reserved vertex, to write indices with
+    ImU32           Col;
+    float           Thickness;
+    float           FringeScale;
+    ImDrawListFlags Flags;
+    bool            Closed;
+    bool            Filled;             // AddConvexPolyFilled() if true, AddPolyline() otherwise
 };
 
 // Draw command list
@@ -2342,6 +2371,10 @@ struct ImDrawList
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    ImVector<ImDrawDeferredShape> _DeferredShapes;  // [Internal] [UnrealImGui] shapes waiting for _TessellateDeferred()
+    ImVector<ImVec2>        _DeferredPoints;    // [Internal] [UnrealImGui] points of _DeferredShapes
+    ImVector<ImVec2>        _DeferredTemp;      // [Internal] [UnrealImGui] tessellation scratch while replaying, instead of the stack of whichever thread does it
+    bool                    _TessellatingDeferred; // [Internal] [UnrealImGui] set while _TessellateDeferred() writes into geometry reserved earlier
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
     ImDrawList(const ImDrawListSharedData* shared_data) { memset(this, 0, sizeof(*this)); _Data = shared_data; }
@@ -2439,6 +2472,8 @@ struct ImDrawList
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
+    IMGUI_API void  _DeferShape(const ImVec2* points, int points_count, ImU32 col, bool closed, float thickness, bool filled); // [UnrealImGui]
+    IMGUI_API void  _TessellateDeferred();      // [UnrealImGui] Writes the geometry of _DeferredShapes. Must be called before reading or moving VtxBuffer/IdxBuffer. Only touches this draw list.
 };
 
 // All draw data to render a Dear ImGui frame
@@ -2505,6 +2540,15 @@ struct ImFontGlyph
     float           U0, V0, U1, V1;     // Texture coordinates
 };
 
+// [UnrealImGui] Result of one ImFont::CalcTextSizeA() call, reused while the same string is measured with the same parameters
+struct ImFontTextSizeCacheEntry
+{
+    ImU64           Hash;               // 64-bit hash of the text and of the size/max_width/wrap_width it was measured with, wide enough that colliding strings are never expected
+    int             TextLength;         // -1 for an empty entry
+    int             RemainingOffset;    // Offset of *remaining from the start of the text
+    ImVec2          Size;
+};
+
 // Helper to build glyph ranges from text/string data. Feed your application strings/characters to it then call BuildRanges().
 // This is essentially a tightly packed of vector of 64k booleans = 8KB storage.
 struct ImFontGlyphRangesBuilder
@@ -2540,7 +2584,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_SignedDistanceField = 1 << 3   // [UnrealImGui] Store glyphs as signed distance fields (0.5 on the outline, see TexSdfSpread) so they can be drawn sharp at any scale. Requires ImFontAtlasFlags_NoBakedLines. stb_truetype builder only.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2560,6 +2605,18 @@ enum ImFontAtlasFlags_
 //   You can set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed,
 // - Even though many functions are suffixed with "TTF", OTF data is supported just as well.
 // - This is an old API and it is currently awkward for those and and various other reasons! We will address them in the future!
+// [UnrealImGui] Called when a font has no glyph for a codepoint yet, see ImFontAtlas::GlyphLoader.
+// Returns true if it added the glyph to the font (and its lookup tables), false to use the fallback glyph.
+typedef bool (*ImFontGlyphLoader)(ImFont* font, ImWchar c);
+// [UnrealImGui] See ImFontAtlas::BuildParallelFor.
+typedef ImGuiParallelFor ImFontAtlasParallelFor;
+// [UnrealImGui] A glyph of a font, see ImFontAtlas::GlyphsUseLog.
+struct ImFontGlyphRef
+{
+    const ImFont*   Font;
+    int             GlyphIndex;
+};
+
 struct ImFontAtlas
 {
     IMGUI_API ImFontAtlas();
@@ -2629,6 +2686,7 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    int                         TexSdfSpread;       // [UnrealImGui] With ImFontAtlasFlags_SignedDistanceField: distance in pixels (at the font's size) from the outline to where the field saturates. Defaults to 4.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -2647,6 +2705,18 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [UnrealImGui] Dynamic glyphs
+    // When set, glyphs missing from the lookup tables are requested from GlyphLoader instead of immediately using the fallback glyph.
+    // Codepoints with a negative IndexAdvanceX haven't been requested yet, the loader maps codepoints it can't provide to the fallback glyph itself.
+    ImFontGlyphLoader           GlyphLoader;
+    void*                       GlyphLoaderUserData;
+    // When set, glyphs stamped with ImFont::StampGlyphUsed() are also appended here, possibly more than once. Lets retained windows know which glyphs they draw.
+    ImVector<ImFontGlyphRef>*   GlyphsUseLog;
+
+    // [UnrealImGui] Parallel build
+    // When set, Build() measures and rasterizes each source font (ImFontConfig) as a separate job. Jobs only share read-only data and write disjoint atlas rectangles.
+    ImFontAtlasParallelFor      BuildParallelFor;
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
@@ -2679,12 +2749,21 @@ struct ImFont
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
 
+    // [UnrealImGui] Dynamic glyphs (see ImFontAtlas::GlyphLoader)
+    mutable ImVector<int>       GlyphsLastUsed;     //       // out //            // Parallel to Glyphs while a GlyphLoader manages this font. FindGlyph() stamps used glyphs with GlyphsUseStamp, see StampGlyphUsed().
+    int                         GlyphsUseStamp;     // 4     // in  //            // Current stamp, advanced by the GlyphLoader every frame
+    mutable int                 GlyphsLoadCount;    // 4     // out //            // Number of LoadGlyph() calls, CalcTextSizeA() doesn't cache sizes measured while glyphs were loading
+    int                         GlyphsGeneration;   // 4     // out //            // Changes whenever glyphs may have moved in the atlas, see MarkGlyphsChanged()
+
+    // [UnrealImGui] Direct mapped cache of the sizes of wrapped strings, cleared with the lookup tables
+    mutable ImVector<ImFontTextSizeCacheEntry> TextSizeCache;
+
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
     IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c) const     { float advance_x = ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : -1.0f; return (advance_x >= 0.0f) ? advance_x : LoadCharAdvance(c); }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -2704,6 +2783,11 @@ struct ImFont
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
     IMGUI_API void              SetFallbackChar(ImWchar c);
     IMGUI_API bool              IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
+    IMGUI_API const ImFontGlyph*LoadGlyph(ImWchar c) const;         // [UnrealImGui] Slow path of FindGlyph(), asks ContainerAtlas->GlyphLoader for the glyph
+    IMGUI_API float             LoadCharAdvance(ImWchar c) const;   // [UnrealImGui] Slow path of GetCharAdvance()
+    IMGUI_API void              ClearTextSizeCache() const;         // [UnrealImGui] Call after changing IndexAdvanceX outside of BuildLookupTable()
+    IMGUI_API void              MarkGlyphsChanged();                // [UnrealImGui] Invalidates glyph quads cached by ImGui::RenderText(), call after evicting or moving glyphs
+    void                        StampGlyphUsed(int glyph_index) const { if (glyph_index < GlyphsLastUsed.Size) { GlyphsLastUsed.Data[glyph_index] = GlyphsUseStamp; if (ContainerAtlas->GlyphsUseLog) { ImFontGlyphRef ref = { this, glyph_index }; ContainerAtlas->GlyphsUseLog->push_back(ref); } } } // [UnrealImGui] Keeps a glyph resident while a GlyphLoader manages this font
 };
 
 #if defined(__clang__)
@@ -406,6 +406,8 @@ void ImDrawList::_ResetForNewFrame()
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = 1.0f;
+    _DeferredShapes.resize(0); // [UnrealImGui]
+    _DeferredPoints.resize(0);
 }
 
 void ImDrawList::_ClearFreeMemory()
@@ -421,10 +423,14 @@ void ImDrawList::_ClearFreeMemory()
     _TextureIdStack.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _DeferredShapes.clear(); // [UnrealImGui]
+    _DeferredPoints.clear();
+    _DeferredTemp.clear();
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
 {
+    const_cast<ImDrawList*>(this)->_TessellateDeferred(); // [UnrealImGui] Output isn't complete until then
     ImDrawList* dst = IM_NEW(ImDrawList(_Data));
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
@@ -672,6 +678,206 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     do { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = 1.0f / ImSqrt(d2); VX *= inv_len; VY *= inv_len; } } while (0)
 #define IM_FIXNORMAL2F(VX,VY)               do { float d2 = VX*VX + VY*VY; if (d2 < 0.5f) d2 = 0.5f; float inv_lensq = 1.0f / d2; VX *= inv_lensq; VY *= inv_lensq; } while (0)
 
+// [UnrealImGui] Normal kernels shared by AddPolyline() and AddConvexPolyFilled(). With IMGUI_SIMD_TESSELLATION (bImGuiSimdTessellation in
+// UnrealImGui.Build.cs) they process 4 points per iteration with SSE2 or NEON, finishing with the scalar macros above. The vector paths use exact
+// sqrt/div and the same operation order, so their results are bitwise identical to the scalar ones (UnrealImGui.SimdTessellation.MatchesScalar).
+// That only holds while the scalar code isn't contracted into FMAs, which clang does by default for AArch64 and FMA-enabled x64 targets.
+// MSVC only contracts with /fp:contract or /fp:fast.
+#if defined(__clang__)
+#define IM_TESSELLATION_NO_FP_CONTRACT      _Pragma("clang fp contract(off)")
+#else
+#define IM_TESSELLATION_NO_FP_CONTRACT
+#endif
+#if defined(IMGUI_SIMD_TESSELLATION) && IMGUI_SIMD_TESSELLATION
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IM_TESSELLATION_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>                   // vsqrtq_f32/vdivq_f32 are AArch64 only
+#define IM_TESSELLATION_NEON
+#endif
+#endif
+IM_STATIC_ASSERT(sizeof(ImVec2) == sizeof(float) * 2);
+
+// Scalar normals of segments [segments_begin, segments_end)
+static inline void ImComputeSegmentNormalsRange(const ImVec2* points, const int points_count, const int segments_begin, const int segments_end, ImVec2* out_normals)
+{
+    IM_TESSELLATION_NO_FP_CONTRACT
+    for (int i1 = segments_begin; i1 < segments_end; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// Scalar miter directions of points [points_begin, points_end)
+static inline void ImComputeAveragedNormalsRange(const ImVec2* normals, const int points_count, const int points_begin, const int points_end, ImVec2* out_normals)
+{
+    IM_TESSELLATION_NO_FP_CONTRACT
+    for (int i1 = points_begin; i1 < points_end; i1++)
+    {
+        const int i0 = (i1 == 0) ? points_count - 1 : i1 - 1;
+        float dm_x = (normals[i0].x + normals[i1].x) * 0.5f;
+        float dm_y = (normals[i0].y + normals[i1].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_normals[i1].x = dm_x;
+        out_normals[i1].y = dm_y;
+    }
+}
+
+// Normal of each segment [i, i+1], the last one wrapping around to points[0] when segments_count == points_count
+void ImComputeSegmentNormals(const ImVec2* points, const int points_count, const int segments_count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#if defined(IM_TESSELLATION_SSE2)
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i1 + 4 <= segments_count && i1 + 4 < points_count; i1 += 4)
+    {
+        const __m128 a01 = _mm_loadu_ps(&points[i1].x);         // x0 y0 x1 y1
+        const __m128 a23 = _mm_loadu_ps(&points[i1 + 2].x);     // x2 y2 x3 y3
+        const __m128 b01 = _mm_loadu_ps(&points[i1 + 1].x);
+        const __m128 b23 = _mm_loadu_ps(&points[i1 + 3].x);
+        __m128 dx = _mm_sub_ps(_mm_shuffle_ps(b01, b23, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128 dy = _mm_sub_ps(_mm_shuffle_ps(b01, b23, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1)));
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 non_zero = _mm_cmpgt_ps(d2, zero);
+        const __m128 inv_len = _mm_div_ps(one, _mm_sqrt_ps(d2));
+        dx = _mm_or_ps(_mm_and_ps(non_zero, _mm_mul_ps(dx, inv_len)), _mm_andnot_ps(non_zero, dx));
+        dy = _mm_or_ps(_mm_and_ps(non_zero, _mm_mul_ps(dy, inv_len)), _mm_andnot_ps(non_zero, dy));
+        const __m128 nx = dy;
+        const __m128 ny = _mm_xor_ps(dx, sign_mask);
+        _mm_storeu_ps(&out_normals[i1].x, _mm_unpacklo_ps(nx, ny));
+        _mm_storeu_ps(&out_normals[i1 + 2].x, _mm_unpackhi_ps(nx, ny));
+    }
+#elif defined(IM_TESSELLATION_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i1 + 4 <= segments_count && i1 + 4 < points_count; i1 += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(&points[i1].x);       // Deinterleaved into x0..x3, y0..y3
+        const float32x4x2_t b = vld2q_f32(&points[i1 + 1].x);
+        float32x4_t dx = vsubq_f32(b.val[0], a.val[0]);
+        float32x4_t dy = vsubq_f32(b.val[1], a.val[1]);
+        const float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        const uint32x4_t non_zero = vcgtq_f32(d2, zero);
+        const float32x4_t inv_len = vdivq_f32(one, vsqrtq_f32(d2));
+        dx = vbslq_f32(non_zero, vmulq_f32(dx, inv_len), dx);
+        dy = vbslq_f32(non_zero, vmulq_f32(dy, inv_len), dy);
+        float32x4x2_t n;
+        n.val[0] = dy;
+        n.val[1] = vnegq_f32(dx);
+        vst2q_f32(&out_normals[i1].x, n);
+    }
+#endif
+    ImComputeSegmentNormalsRange(points, points_count, i1, segments_count, out_normals);
+}
+
+void ImComputeSegmentNormalsScalar(const ImVec2* points, const int points_count, const int segments_count, ImVec2* out_normals)
+{
+    ImComputeSegmentNormalsRange(points, points_count, 0, segments_count, out_normals);
+}
+
+// Miter direction at each point: the average of the normals of the segments ending and starting there, point 0 pairing with the last segment
+void ImComputeAveragedNormals(const ImVec2* normals, const int points_count, ImVec2* out_normals)
+{
+    ImComputeAveragedNormalsRange(normals, points_count, 0, 1, out_normals);
+    int i1 = 1;
+#if defined(IM_TESSELLATION_SSE2)
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i1 + 4 <= points_count; i1 += 4)
+    {
+        const __m128 p01 = _mm_loadu_ps(&normals[i1 - 1].x);
+        const __m128 p23 = _mm_loadu_ps(&normals[i1 + 1].x);
+        const __m128 c01 = _mm_loadu_ps(&normals[i1].x);
+        const __m128 c23 = _mm_loadu_ps(&normals[i1 + 2].x);
+        __m128 dm_x = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c01, c23, _MM_SHUFFLE(2, 0, 2, 0))), half);
+        __m128 dm_y = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c01, c23, _MM_SHUFFLE(3, 1, 3, 1))), half);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dm_x, dm_x), _mm_mul_ps(dm_y, dm_y));
+        d2 = _mm_max_ps(half, d2);      // (0.5 > d2) ? 0.5 : d2, like the scalar clamp
+        const __m128 inv_lensq = _mm_div_ps(one, d2);
+        dm_x = _mm_mul_ps(dm_x, inv_lensq);
+        dm_y = _mm_mul_ps(dm_y, inv_lensq);
+        _mm_storeu_ps(&out_normals[i1].x, _mm_unpacklo_ps(dm_x, dm_y));
+        _mm_storeu_ps(&out_normals[i1 + 2].x, _mm_unpackhi_ps(dm_x, dm_y));
+    }
+#elif defined(IM_TESSELLATION_NEON)
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i1 + 4 <= points_count; i1 += 4)
+    {
+        const float32x4x2_t p = vld2q_f32(&normals[i1 - 1].x);
+        const float32x4x2_t c = vld2q_f32(&normals[i1].x);
+        float32x4x2_t dm;
+        dm.val[0] = vmulq_f32(vaddq_f32(p.val[0], c.val[0]), half);
+        dm.val[1] = vmulq_f32(vaddq_f32(p.val[1], c.val[1]), half);
+        float32x4_t d2 = vaddq_f32(vmulq_f32(dm.val[0], dm.val[0]), vmulq_f32(dm.val[1], dm.val[1]));
+        d2 = vbslq_f32(vcltq_f32(d2, half), half, d2);
+        const float32x4_t inv_lensq = vdivq_f32(one, d2);
+        dm.val[0] = vmulq_f32(dm.val[0], inv_lensq);
+        dm.val[1] = vmulq_f32(dm.val[1], inv_lensq);
+        vst2q_f32(&out_normals[i1].x, dm);
+    }
+#endif
+    ImComputeAveragedNormalsRange(normals, points_count, i1, points_count, out_normals);
+}
+
+void ImComputeAveragedNormalsScalar(const ImVec2* normals, const int points_count, ImVec2* out_normals)
+{
+    ImComputeAveragedNormalsRange(normals, points_count, 0, points_count, out_normals);
+}
+
+// [UnrealImGui] Scratch space for tessellating deferred shapes, owned by the draw list so jobs on different draw lists don't share it
+static ImVec2* ImDrawListDeferredTemp(ImDrawList* draw_list, int count)
+{
+    if (draw_list->_DeferredTemp.Size < count)
+        draw_list->_DeferredTemp.resize(count);
+    return draw_list->_DeferredTemp.Data;
+}
+
+// [UnrealImGui] Geometry AddPolyline() writes for these arguments, so deferred shapes can reserve it up front. Keep in sync with AddPolyline()
+static void ImPolylineGeometryCount(ImDrawListFlags flags, float fringe_scale, int points_count, bool closed, float thickness, int* out_idx_count, int* out_vtx_count)
+{
+    const int count = closed ? points_count : points_count - 1;
+    const bool thick_line = (thickness > fringe_scale);
+    if (flags & ImDrawListFlags_AntiAliasedLines)
+    {
+        thickness = ImMax(thickness, 1.0f);
+        const int integer_thickness = (int)thickness;
+        const float fractional_thickness = thickness - integer_thickness;
+        const bool use_texture = (flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (fringe_scale == 1.0f);
+        const bool two_vertices = use_texture || (flags & ImDrawListFlags_AntiAliasedLinesAnalytic);
+        *out_idx_count = two_vertices ? (count * 6) : (thick_line ? count * 18 : count * 12);
+        *out_vtx_count = two_vertices ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
+    }
+    else
+    {
+        *out_idx_count = count * 6;
+        *out_vtx_count = count * 4;
+    }
+}
+
+// [UnrealImGui] Geometry AddConvexPolyFilled() writes for these arguments. Keep in sync with AddConvexPolyFilled()
+static void ImConvexPolyFilledGeometryCount(ImDrawListFlags flags, int points_count, int* out_idx_count, int* out_vtx_count)
+{
+    if (flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        *out_idx_count = (points_count - 2) * 3 + points_count * 6;
+        *out_vtx_count = points_count * 2;
+    }
+    else
+    {
+        *out_idx_count = (points_count - 2) * 3;
+        *out_vtx_count = points_count;
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
@@ -679,6 +885,13 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
     if (points_count < 2)
         return;
 
+    // [UnrealImGui] Only reserve the geometry for now, _TessellateDeferred() calls us back to write it
+    if (Flags & ImDrawListFlags_DeferTessellation)
+    {
+        _DeferShape(points, points_count, col, closed, thickness, false);
+        return;
+    }
+
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
     const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
     const bool thick_line = (thickness > _FringeScale);
@@ -702,32 +915,35 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
         IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
 
-        const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
-        const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
-        PrimReserve(idx_count, vtx_count);
+        // [UnrealImGui] Lines the atlas has no texture for can still get away with 2 vertices per point when the renderer resolves coverage itself
+        const bool use_analytic = !use_texture && (Flags & ImDrawListFlags_AntiAliasedLinesAnalytic);
+        const bool two_vertices = use_texture || use_analytic;
+
+        const int idx_count = two_vertices ? (count * 6) : (thick_line ? count * 18 : count * 12);
+        const int vtx_count = two_vertices ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
+        if (!_TessellatingDeferred) // [UnrealImGui] Already reserved by _DeferShape()
+            PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
         // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * ((use_texture || !thick_line) ? 3 : 5) * sizeof(ImVec2)); //-V630
+        // [UnrealImGui] Followed by the averaged normals at each point
+        // [UnrealImGui] Replayed deferred shapes run on worker threads with small stacks, they use _DeferredTemp instead
+        const int temp_count = points_count * ((two_vertices || !thick_line) ? 4 : 6);
+        ImVec2* temp_normals = _TessellatingDeferred ? ImDrawListDeferredTemp(this, temp_count) : (ImVec2*)alloca(temp_count * sizeof(ImVec2)); //-V630
         ImVec2* temp_points = temp_normals + points_count;
+        ImVec2* temp_averaged_normals = temp_points + points_count * ((two_vertices || !thick_line) ? 2 : 4);
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        ImComputeSegmentNormals(points, points_count, count, temp_normals); // [UnrealImGui]
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        ImComputeAveragedNormals(temp_normals, points_count, temp_averaged_normals); // [UnrealImGui]
 
         // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
-        if (use_texture || !thick_line)
+        if (two_vertices || !thick_line)
         {
             // [PATH 1] Texture-based lines (thick or non-thick)
+            // [PATH 1b] [UnrealImGui] Analytic lines (thick or non-thick)
             // [PATH 2] Non texture-based lines (non-thick)
 
             // The width of the geometry we need to draw - this is essentially <thickness> pixels for the line itself, plus "one pixel" for AA.
@@ -735,7 +951,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   (see ImFontAtlasBuildRenderLinesTexData() function), and so alternate values won't work without changes to that code.
             // - In the non texture-based paths, we would allow AA_SIZE to potentially be != 1.0f with a patch (e.g. fringe_scale patch to
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
-            const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
+            // - [UnrealImGui] Analytic lines cover the same area as the thick fringe path: coverage fades out over AA_SIZE straddling each edge of the line.
+            const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : use_analytic ? (ImMax(thickness, AA_SIZE) + AA_SIZE) * 0.5f : AA_SIZE;
 
             // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
             if (!closed)
@@ -753,12 +970,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
+                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (two_vertices ? 2 : 3)); // Vertex index for end of segment
 
                 // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
+                float dm_x = temp_averaged_normals[i2].x; // [UnrealImGui] Averaged up front by ImComputeAveragedNormals()
+                float dm_y = temp_averaged_normals[i2].y;
                 dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
                 dm_y *= half_draw_size;
 
@@ -769,7 +985,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[1].x = points[i2].x - dm_x;
                 out_vtx[1].y = points[i2].y - dm_y;
 
-                if (use_texture)
+                if (two_vertices)
                 {
                     // Add indices for two triangles
                     _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
@@ -811,6 +1027,21 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                     _VtxWritePtr += 2;
                 }
             }
+            else if (use_analytic)
+            {
+                // [UnrealImGui] uv.x is the distance to the center over half_draw_size (interpolated from +1 to -1 across the line),
+                // uv.y is -AA_SIZE / half_draw_size, negative to tell these vertices apart. The renderer resolves coverage as saturate((1 - abs(uv.x)) / -uv.y),
+                // which matches the fringe paths: opaque over the core, fading to 0 over AA_SIZE. Both stay within [-1, 1].
+                const float aa_ratio = -AA_SIZE / half_draw_size;
+                const ImVec2 uv_left(1.0f, aa_ratio);
+                const ImVec2 uv_right(-1.0f, aa_ratio);
+                for (int i = 0; i < points_count; i++)
+                {
+                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = uv_left; _VtxWritePtr[0].col = col;  // Left-side outer edge
+                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = uv_right; _VtxWritePtr[1].col = col; // Right-side outer edge
+                    _VtxWritePtr += 2;
+                }
+            }
             else
             {
                 // If we're not using a texture, we need the center vertex as well
@@ -852,9 +1083,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
+                float dm_x = temp_averaged_normals[i2].x; // [UnrealImGui] Averaged up front by ImComputeAveragedNormals()
+                float dm_y = temp_averaged_normals[i2].y;
                 float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
                 float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
                 float dm_in_x = dm_x * half_inner_thickness;
@@ -900,7 +1130,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         // [PATH 4] Non texture-based, Non anti-aliased lines
         const int idx_count = count * 6;
         const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
-        PrimReserve(idx_count, vtx_count);
+        if (!_TessellatingDeferred) // [UnrealImGui] Already reserved by _DeferShape()
+            PrimReserve(idx_count, vtx_count);
 
         for (int i1 = 0; i1 < count; i1++)
         {
@@ -934,6 +1165,13 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     if (points_count < 3)
         return;
 
+    // [UnrealImGui] Only reserve the geometry for now, _TessellateDeferred() calls us back to write it
+    if (Flags & ImDrawListFlags_DeferTessellation)
+    {
+        _DeferShape(points, points_count, col, true, 0.0f, true);
+        return;
+    }
+
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
     if (Flags & ImDrawListFlags_AntiAliasedFill)
@@ -943,7 +1181,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         const ImU32 col_trans = col & ~IM_COL32_A_MASK;
         const int idx_count = (points_count - 2)*3 + points_count * 6;
         const int vtx_count = (points_count * 2);
-        PrimReserve(idx_count, vtx_count);
+        if (!_TessellatingDeferred) // [UnrealImGui] Already reserved by _DeferShape()
+            PrimReserve(idx_count, vtx_count);
 
         // Add indexes for fill
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
@@ -955,26 +1194,17 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         }
 
         // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        // [UnrealImGui] Followed by the averaged normals at each point
+        ImVec2* temp_normals = _TessellatingDeferred ? ImDrawListDeferredTemp(this, points_count * 2) : (ImVec2*)alloca(points_count * 2 * sizeof(ImVec2)); //-V630
+        ImVec2* temp_averaged_normals = temp_normals + points_count;
+        ImComputeSegmentNormals(points, points_count, points_count, temp_normals);
+        ImComputeAveragedNormals(temp_normals, points_count, temp_averaged_normals);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
             // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
+            float dm_x = temp_averaged_normals[i1].x;
+            float dm_y = temp_averaged_normals[i1].y;
             dm_x *= AA_SIZE * 0.5f;
             dm_y *= AA_SIZE * 0.5f;
 
@@ -995,7 +1225,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         // Non Anti-aliased Fill
         const int idx_count = (points_count - 2)*3;
         const int vtx_count = points_count;
-        PrimReserve(idx_count, vtx_count);
+        if (!_TessellatingDeferred) // [UnrealImGui] Already reserved by _DeferShape()
+            PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
             _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
@@ -1010,6 +1241,84 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     }
 }
 
+// [UnrealImGui] Reserves the geometry of a stroke or convex fill and records what to write into it.
+// Draw commands are final from here on (PrimReserve() updates them), only the vertices and indices are left to _TessellateDeferred().
+void ImDrawList::_DeferShape(const ImVec2* points, int points_count, ImU32 col, bool closed, float thickness, bool filled)
+{
+    const ImDrawListFlags shape_flags = Flags & ~ImDrawListFlags_DeferTessellation;
+    int idx_count, vtx_count;
+    if (filled)
+        ImConvexPolyFilledGeometryCount(shape_flags, points_count, &idx_count, &vtx_count);
+    else
+        ImPolylineGeometryCount(shape_flags, _FringeScale, points_count, closed, thickness, &idx_count, &vtx_count);
+    PrimReserve(idx_count, vtx_count);
+
+    // Points are usually _Path, which is reused right after we return
+    _DeferredShapes.resize(_DeferredShapes.Size + 1);
+    ImDrawDeferredShape& shape = _DeferredShapes.back();
+    shape.PointsOffset = _DeferredPoints.Size;
+    shape.PointsCount = points_count;
+    shape.VtxOffset = (int)(_VtxWritePtr - VtxBuffer.Data);
+    shape.VtxCount = vtx_count;
+    shape.IdxOffset = (int)(_IdxWritePtr - IdxBuffer.Data);
+    shape.IdxCount = idx_count;
+    shape.VtxCurrentIdx = _VtxCurrentIdx;
+    shape.Col = col;
+    shape.Thickness = thickness;
+    shape.FringeScale = _FringeScale;
+    shape.Flags = shape_flags;
+    shape.Closed = closed;
+    shape.Filled = filled;
+    _DeferredPoints.resize(_DeferredPoints.Size + points_count);
+    memcpy(_DeferredPoints.Data + shape.PointsOffset, points, (size_t)points_count * sizeof(ImVec2));
+
+    _VtxWritePtr += vtx_count;
+    _IdxWritePtr += idx_count;
+    _VtxCurrentIdx += vtx_count;
+}
+
+// [UnrealImGui] Replays the recorded shapes into the geometry they reserved, with the settings they were recorded with.
+// Doesn't allocate anything but _DeferredTemp, so different draw lists can be tessellated on different threads.
+void ImDrawList::_TessellateDeferred()
+{
+    if (_DeferredShapes.Size == 0)
+        return;
+    IM_ASSERT(!_TessellatingDeferred);
+
+    ImDrawVert* backup_vtx_write_ptr = _VtxWritePtr;
+    ImDrawIdx* backup_idx_write_ptr = _IdxWritePtr;
+    const unsigned int backup_vtx_current_idx = _VtxCurrentIdx;
+    const ImDrawListFlags backup_flags = Flags;
+    const float backup_fringe_scale = _FringeScale;
+
+    _TessellatingDeferred = true;
+    for (int shape_n = 0; shape_n < _DeferredShapes.Size; shape_n++)
+    {
+        const ImDrawDeferredShape& shape = _DeferredShapes.Data[shape_n];
+        _VtxWritePtr = VtxBuffer.Data + shape.VtxOffset;
+        _IdxWritePtr = IdxBuffer.Data + shape.IdxOffset;
+        _VtxCurrentIdx = shape.VtxCurrentIdx;
+        Flags = shape.Flags;
+        _FringeScale = shape.FringeScale;
+
+        const ImVec2* points = _DeferredPoints.Data + shape.PointsOffset;
+        if (shape.Filled)
+            AddConvexPolyFilled(points, shape.PointsCount, shape.Col);
+        else
+            AddPolyline(points, shape.PointsCount, shape.Col, shape.Closed, shape.Thickness);
+        IM_ASSERT(_VtxWritePtr == VtxBuffer.Data + shape.VtxOffset + shape.VtxCount && _IdxWritePtr == IdxBuffer.Data + shape.IdxOffset + shape.IdxCount);
+    }
+    _TessellatingDeferred = false;
+
+    _VtxWritePtr = backup_vtx_write_ptr;
+    _IdxWritePtr = backup_idx_write_ptr;
+    _VtxCurrentIdx = backup_vtx_current_idx;
+    Flags = backup_flags;
+    _FringeScale = backup_fringe_scale;
+    _DeferredShapes.resize(0);
+    _DeferredPoints.resize(0);
+}
+
 void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12)
 {
     if (radius == 0.0f || a_min_of_12 > a_max_of_12)
@@ -1594,6 +1903,9 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     if (_Current == idx)
         return;
 
+    // [UnrealImGui] Deferred shapes point into the index buffer we're about to swap out
+    draw_list->_TessellateDeferred();
+
     // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
     memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
     memcpy(&_Channels.Data[_Current]._IdxBuffer, &draw_list->IdxBuffer, sizeof(draw_list->IdxBuffer));
@@ -1658,6 +1970,7 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    draw_list->_TessellateDeferred(); // [UnrealImGui] The vertices must be written before we can shade them
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
@@ -1682,6 +1995,7 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    draw_list->_TessellateDeferred(); // [UnrealImGui] The vertices must be written before we can shade them
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -1790,6 +2104,7 @@ ImFontAtlas::ImFontAtlas()
     TexID = (ImTextureID)NULL;
     TexDesiredWidth = 0;
     TexGlyphPadding = 1;
+    TexSdfSpread = 4;
 
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
@@ -1797,6 +2112,10 @@ ImFontAtlas::ImFontAtlas()
     TexUvScale = ImVec2(0.0f, 0.0f);
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     PackIdMouseCursors = PackIdLines = -1;
+    GlyphLoader = NULL;
+    GlyphLoaderUserData = NULL;
+    GlyphsUseLog = NULL;
+    BuildParallelFor = NULL;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -2101,6 +2420,16 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+// [UnrealImGui] Distance field of one glyph, rasterized up front since stb_truetype can't render them into packed rectangles
+struct ImFontBuildSdfGlyph
+{
+    unsigned char*      Bitmap;             // From stbtt_GetGlyphSDF(), freed once copied into the atlas
+    int                 Width, Height;
+    int                 OffsetX, OffsetY;   // Top-left corner relative to the pen position (includes the spread)
+    int                 X, Y;               // Position in the atlas, once packed
+    float               AdvanceX;
+};
+
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
 struct ImFontBuildSrcData
@@ -2115,6 +2444,8 @@ struct ImFontBuildSrcData
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsMap)
+    int                 GlyphsSurface;      // [UnrealImGui] Total surface of Rects, measured by ImFontAtlasBuildGatherSrcRects()
+    ImVector<ImFontBuildSdfGlyph> SdfGlyphs;  // [UnrealImGui] Parallel to GlyphsList with ImFontAtlasFlags_SignedDistanceField
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -2138,9 +2469,118 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// [UnrealImGui] Per source font steps of ImFontAtlasBuildWithStbTruetype(), run through ImFontAtlas::BuildParallelFor when available
+struct ImFontBuildJobData
+{
+    ImFontAtlas*                Atlas;
+    ImFontBuildSrcData*         SrcTmpArray;
+    const stbtt_pack_context*   PackContext;        // Only for ImFontAtlasBuildRenderSrcRects()
+};
+
+static void ImFontAtlasBuildRunJobs(ImFontAtlas* atlas, int count, void (*job)(void* job_data, int index), void* job_data)
+{
+    if (atlas->BuildParallelFor != NULL && count > 1)
+    {
+        atlas->BuildParallelFor(count, job, job_data);
+        return;
+    }
+    for (int i = 0; i < count; i++)
+        job(job_data, i);
+}
+
+// Gather the sizes of all rectangles we will need to pack (this is based on stbtt_PackFontRangesGatherRects)
+static void ImFontAtlasBuildGatherSrcRects(void* job_data, int src_i)
+{
+    ImFontBuildJobData* data = (ImFontBuildJobData*)job_data;
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[src_i];
+    if (src_tmp.GlyphsCount == 0)
+        return;
+
+    const ImFontConfig& cfg = data->Atlas->ConfigData[src_i];
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+    const int padding = data->Atlas->TexGlyphPadding;
+    const bool sdf = (data->Atlas->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+    if (sdf)
+        src_tmp.SdfGlyphs.resize(src_tmp.GlyphsList.Size);
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+    {
+        int x0, y0, x1, y1;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
+        IM_ASSERT(glyph_index_in_font != 0);
+        if (sdf)
+        {
+            // The field is rasterized at the font's size, oversampling doesn't apply. Empty glyphs (e.g. space) return no bitmap.
+            ImFontBuildSdfGlyph& sdf_glyph = src_tmp.SdfGlyphs[glyph_i];
+            memset(&sdf_glyph, 0, sizeof(sdf_glyph));
+            const int spread = ImMax(data->Atlas->TexSdfSpread, 1);
+            sdf_glyph.Bitmap = stbtt_GetGlyphSDF(&src_tmp.FontInfo, scale, glyph_index_in_font, spread, 128, 128.0f / spread, &sdf_glyph.Width, &sdf_glyph.Height, &sdf_glyph.OffsetX, &sdf_glyph.OffsetY);
+            if (sdf_glyph.Bitmap == NULL)
+                sdf_glyph.Width = sdf_glyph.Height = 0;
+            int advance_x, left_side_bearing;
+            stbtt_GetGlyphHMetrics(&src_tmp.FontInfo, glyph_index_in_font, &advance_x, &left_side_bearing);
+            sdf_glyph.AdvanceX = advance_x * scale;
+            src_tmp.Rects[glyph_i].w = (stbrp_coord)(sdf_glyph.Width + padding);
+            src_tmp.Rects[glyph_i].h = (stbrp_coord)(sdf_glyph.Height + padding);
+            src_tmp.GlyphsSurface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            continue;
+        }
+        stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+        src_tmp.GlyphsSurface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+    }
+}
+
+// Render/rasterize the characters of one source font into their (already packed) rectangles
+static void ImFontAtlasBuildRenderSrcRects(void* job_data, int src_i)
+{
+    ImFontBuildJobData* data = (ImFontBuildJobData*)job_data;
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[src_i];
+    if (src_tmp.GlyphsCount == 0)
+        return;
+
+    // [UnrealImGui] Distance fields were rasterized while gathering, copy them into place
+    if (data->Atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+    {
+        const int stride = data->Atlas->TexWidth;
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
+        {
+            ImFontBuildSdfGlyph& sdf_glyph = src_tmp.SdfGlyphs[glyph_i];
+            const stbrp_rect& r = src_tmp.Rects[glyph_i];
+            sdf_glyph.X = r.x;
+            sdf_glyph.Y = r.y;
+            if (sdf_glyph.Bitmap == NULL)
+                continue;
+            if (r.was_packed)
+                for (int y = 0; y < sdf_glyph.Height; y++)
+                    memcpy(data->Atlas->TexPixelsAlpha8 + (r.y + y) * stride + r.x, sdf_glyph.Bitmap + y * sdf_glyph.Width, (size_t)sdf_glyph.Width);
+            stbtt_FreeSDF(sdf_glyph.Bitmap, NULL);
+            sdf_glyph.Bitmap = NULL;
+        }
+        return;
+    }
+
+    // stbtt_PackFontRangesRenderIntoRects() writes the oversampling of the range into the context, so every job works on its own copy
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
+
+    // Apply multiply operator
+    const ImFontConfig& cfg = data->Atlas->ConfigData[src_i];
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = &src_tmp.Rects[0];
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, data->Atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, data->Atlas->TexWidth * 1);
+    }
+}
+
 bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
+    IM_ASSERT((!(atlas->Flags & ImFontAtlasFlags_SignedDistanceField) || (atlas->Flags & ImFontAtlasFlags_NoBakedLines)) && "Baked lines hold coverage, they can't be sampled as a distance field."); // [UnrealImGui]
 
     ImFontAtlasBuildInit(atlas);
 
@@ -2241,6 +2681,10 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
+    ImFontBuildJobData job_data;
+    job_data.Atlas = atlas;
+    job_data.SrcTmpArray = src_tmp_array.Data;
+    job_data.PackContext = NULL;
     int total_surface = 0;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
@@ -2264,21 +2708,10 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.chardata_for_range = src_tmp.PackedChars;
         src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
-
-        // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
-        {
-            int x0, y0, x1, y1;
-            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
-            IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
-        }
     }
+    ImFontAtlasBuildRunJobs(atlas, src_tmp_array.Size, ImFontAtlasBuildGatherSrcRects, &job_data); // [UnrealImGui] Measured per source font
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        total_surface += src_tmp_array[src_i].GlyphsSurface;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -2322,27 +2755,10 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    job_data.PackContext = &spc;
+    ImFontAtlasBuildRunJobs(atlas, src_tmp_array.Size, ImFontAtlasBuildRenderSrcRects, &job_data); // [UnrealImGui] Rasterized per source font
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
-        {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
-        }
-        src_tmp.Rects = NULL;
-    }
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -2373,6 +2789,19 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 
         for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++)
         {
+            // [UnrealImGui] Register distance field glyph
+            if (atlas->Flags & ImFontAtlasFlags_SignedDistanceField)
+            {
+                const ImFontBuildSdfGlyph& sdf_glyph = src_tmp.SdfGlyphs[glyph_i];
+                const float x0 = sdf_glyph.OffsetX + font_off_x;
+                const float y0 = sdf_glyph.OffsetY + font_off_y;
+                const float u0 = sdf_glyph.X * atlas->TexUvScale.x;
+                const float v0 = sdf_glyph.Y * atlas->TexUvScale.y;
+                dst_font->AddGlyph(&cfg, (ImWchar)src_tmp.GlyphsList[glyph_i], x0, y0, x0 + sdf_glyph.Width, y0 + sdf_glyph.Height,
+                    u0, v0, u0 + sdf_glyph.Width * atlas->TexUvScale.x, v0 + sdf_glyph.Height * atlas->TexUvScale.y, sdf_glyph.AdvanceX);
+                continue;
+            }
+
             // Register glyph
             const int codepoint = src_tmp.GlyphsList[glyph_i];
             const stbtt_packedchar& pc = src_tmp.PackedChars[glyph_i];
@@ -2872,6 +3301,9 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    GlyphsUseStamp = 0;
+    GlyphsLoadCount = 0;
+    MarkGlyphsChanged(); // [UnrealImGui]
 }
 
 ImFont::~ImFont()
@@ -2884,8 +3316,11 @@ void    ImFont::ClearOutputData()
     FontSize = 0.0f;
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
+    GlyphsLastUsed.clear();
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    TextSizeCache.clear(); // [UnrealImGui]
+    MarkGlyphsChanged();
     FallbackGlyph = NULL;
     ContainerAtlas = NULL;
     DirtyLookupTables = true;
@@ -2903,6 +3338,8 @@ void ImFont::BuildLookupTable()
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
     IndexAdvanceX.clear();
     IndexLookup.clear();
+    ClearTextSizeCache(); // [UnrealImGui]
+    MarkGlyphsChanged();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
     GrowIndex(max_codepoint + 1);
@@ -2938,9 +3375,10 @@ void ImFont::BuildLookupTable()
     // Setup fall-backs
     FallbackGlyph = FindGlyphNoFallback(FallbackChar);
     FallbackAdvanceX = FallbackGlyph ? FallbackGlyph->AdvanceX : 0.0f;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
-            IndexAdvanceX[i] = FallbackAdvanceX;
+    if (ContainerAtlas == NULL || ContainerAtlas->GlyphLoader == NULL) // [UnrealImGui] Otherwise missing codepoints are left for the GlyphLoader
+        for (int i = 0; i < max_codepoint + 1; i++)
+            if (IndexAdvanceX[i] < 0.0f)
+                IndexAdvanceX[i] = FallbackAdvanceX;
 }
 
 // API is designed this way to avoid exposing the 4K page size
@@ -3041,13 +3479,50 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
     if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
+        return LoadGlyph(c);
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
-        return FallbackGlyph;
+        return LoadGlyph(c);
+    StampGlyphUsed((int)i); // [UnrealImGui] Let the GlyphLoader know which glyphs are still in use
     return &Glyphs.Data[i];
 }
 
+// [UnrealImGui] Dynamic glyphs
+const ImFontGlyph* ImFont::LoadGlyph(ImWchar c) const
+{
+    ImFontAtlas* atlas = ContainerAtlas;
+    if (atlas == NULL || atlas->GlyphLoader == NULL)
+        return FallbackGlyph;
+    GlyphsLoadCount++;
+    if (!atlas->GlyphLoader(const_cast<ImFont*>(this), c))
+        return FallbackGlyph;
+    const ImFontGlyph* glyph = FindGlyphNoFallback(c);
+    if (glyph == NULL)
+        return FallbackGlyph;
+    StampGlyphUsed((int)(glyph - Glyphs.Data)); // The loader stamped it already, but doesn't know about GlyphsUseLog
+    return glyph;
+}
+
+float ImFont::LoadCharAdvance(ImWchar c) const
+{
+    const ImFontGlyph* glyph = LoadGlyph(c);
+    return (glyph != NULL && glyph != FallbackGlyph) ? glyph->AdvanceX : FallbackAdvanceX;
+}
+
+void ImFont::ClearTextSizeCache() const
+{
+    for (int i = 0; i < TextSizeCache.Size; i++)
+        TextSizeCache.Data[i].TextLength = -1;
+}
+
+// Shared by every font, so a font allocated where another one was freed never matches quads cached for the old one
+static int GImFontGlyphsGeneration = 0;
+
+void ImFont::MarkGlyphsChanged()
+{
+    GlyphsGeneration = ++GImFontGlyphsGeneration;
+}
+
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
 {
     if (c >= (size_t)IndexLookup.Size)
@@ -3058,6 +3533,60 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
     return &Glyphs.Data[i];
 }
 
+// [UnrealImGui] Text layout fast paths
+// Sizes are only cached for wrapped strings, which take several passes to measure. Hashing unwrapped text costs about as much as measuring it.
+#define IM_FONT_TEXT_SIZE_CACHE_SIZE        256     // Entries, power of two
+
+// 64-bit FNV-1a, ImHashData() is only 32-bit and the size cache doesn't keep the text around to compare it
+static ImU64 ImFontHashTextSizeKey(const void* data, size_t data_size, ImU64 seed)
+{
+    ImU64 hash = seed;
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t n = 0; n < data_size; n++)
+        hash = (hash ^ bytes[n]) * 0x100000001B3ULL;
+    return hash;
+}
+
+// Returns the end of the run of printable ASCII characters (0x20..0x7F) starting at text, testing 16 bytes per iteration.
+// A byte has its high bit set in ((w - 0x20..20) | w) when it is >= 0x80 or < 0x20. Borrows can only flag further bytes after a real one,
+// so a flagged block always holds the end of the run, which the byte loop then finds.
+static const char* ImTextScanPrintableAscii(const char* text, const char* text_end)
+{
+    const ImU64 spaces = 0x2020202020202020ULL;
+    const ImU64 high_bits = 0x8080808080808080ULL;
+    while (text_end - text >= 16)
+    {
+        ImU64 w0, w1;
+        memcpy(&w0, text, sizeof(w0));
+        memcpy(&w1, text + 8, sizeof(w1));
+        if ((((w0 - spaces) | w0) | ((w1 - spaces) | w1)) & high_bits)
+            break;
+        text += 16;
+    }
+    while (text < text_end && (unsigned char)*text >= 0x20 && (unsigned char)*text < 0x80)
+        text++;
+    return text;
+}
+
+// Looks up the glyphs of count printable ASCII characters the way FindGlyph() does. Stores indices into font->Glyphs (-1 for none),
+// as loading a glyph may reallocate it. Glyphs stamped earlier in the batch are in use this frame, so the GlyphLoader won't evict them.
+static void ImFontFindGlyphIndicesAscii(const ImFont* font, const char* text, int count, int* out_glyph_indices)
+{
+    for (int n = 0; n < count; n++)
+    {
+        const unsigned int c = (unsigned char)text[n];
+        const ImWchar i = (c < (unsigned int)font->IndexLookup.Size) ? font->IndexLookup.Data[c] : (ImWchar)-1;
+        if (i != (ImWchar)-1)
+        {
+            font->StampGlyphUsed((int)i);
+            out_glyph_indices[n] = (int)i;
+            continue;
+        }
+        const ImFontGlyph* glyph = font->LoadGlyph((ImWchar)c);
+        out_glyph_indices[n] = glyph ? (int)(glyph - font->Glyphs.Data) : -1;
+    }
+}
+
 const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
@@ -3112,7 +3641,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
+        const float char_width = GetCharAdvance((ImWchar)c); // [UnrealImGui] Goes through the GlyphLoader for glyphs that aren't loaded yet
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -3162,6 +3691,29 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    // [UnrealImGui] Reuse the size of wrapped strings measured before with the same parameters
+    const int text_length = (int)(text_end - text_begin);
+    const int glyphs_load_count = GlyphsLoadCount;
+    ImFontTextSizeCacheEntry* cache_entry = NULL;
+    ImU64 cache_hash = 0;
+    if (wrap_width > 0.0f)
+    {
+        const float params[3] = { size, max_width, wrap_width };
+        cache_hash = ImFontHashTextSizeKey(text_begin, (size_t)text_length, ImFontHashTextSizeKey(params, sizeof(params), 0xCBF29CE484222325ULL));
+        if (TextSizeCache.Size == 0)
+        {
+            TextSizeCache.resize(IM_FONT_TEXT_SIZE_CACHE_SIZE);
+            ClearTextSizeCache();
+        }
+        cache_entry = &TextSizeCache.Data[(cache_hash ^ (cache_hash >> 32)) & (IM_FONT_TEXT_SIZE_CACHE_SIZE - 1)];
+        if (cache_entry->TextLength == text_length && cache_entry->Hash == cache_hash)
+        {
+            if (remaining)
+                *remaining = text_begin + cache_entry->RemainingOffset;
+            return cache_entry->Size;
+        }
+    }
+
     const float line_height = size;
     const float scale = size / FontSize;
 
@@ -3202,6 +3754,26 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // [UnrealImGui] Printable ASCII runs skip UTF-8 decoding and control characters
+        const char* run_end = ImTextScanPrintableAscii(s, word_wrap_enabled ? word_wrap_eol : text_end);
+        if (run_end != s)
+        {
+            bool reached_max_width = false;
+            for (; s < run_end; s++)
+            {
+                const float char_width = GetCharAdvance((ImWchar)(unsigned char)*s) * scale;
+                if (line_width + char_width >= max_width)
+                {
+                    reached_max_width = true;
+                    break;
+                }
+                line_width += char_width;
+            }
+            if (reached_max_width)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3229,7 +3801,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+        const float char_width = GetCharAdvance((ImWchar)c) * scale; // [UnrealImGui] Goes through the GlyphLoader for glyphs that aren't loaded yet
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -3248,6 +3820,15 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     if (remaining)
         *remaining = s;
 
+    // [UnrealImGui] Glyphs that were loading may have been measured with the fallback advance
+    if (cache_entry != NULL && GlyphsLoadCount == glyphs_load_count)
+    {
+        cache_entry->Hash = cache_hash;
+        cache_entry->TextLength = text_length;
+        cache_entry->RemainingOffset = (int)(s - text_begin);
+        cache_entry->Size = text_size;
+    }
+
     return text_size;
 }
 
@@ -3346,6 +3927,54 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+        // [UnrealImGui] Printable ASCII runs look their glyphs up in batches, then write the quads without decoding or control character tests.
+        // Same float operations in the same order as below, so the vertices are identical.
+        const char* run_end = cpu_fine_clip ? s : ImTextScanPrintableAscii(s, word_wrap_enabled ? word_wrap_eol : text_end);
+        if (run_end != s)
+        {
+            while (s < run_end)
+            {
+                int glyph_indices[64];
+                const int count = ImMin((int)(run_end - s), IM_ARRAYSIZE(glyph_indices));
+                ImFontFindGlyphIndicesAscii(this, s, count, glyph_indices);
+                s += count;
+
+                const ImFontGlyph* glyphs = Glyphs.Data;
+                for (int n = 0; n < count; n++)
+                {
+                    if (glyph_indices[n] < 0)
+                        continue;
+                    const ImFontGlyph* glyph = &glyphs[glyph_indices[n]];
+                    const float char_width = glyph->AdvanceX * scale;
+                    if (glyph->Visible)
+                    {
+                        const float x1 = x + glyph->X0 * scale;
+                        const float x2 = x + glyph->X1 * scale;
+                        if (x1 <= clip_rect.z && x2 >= clip_rect.x)
+                        {
+                            const float y1 = y + glyph->Y0 * scale;
+                            const float y2 = y + glyph->Y1 * scale;
+                            const float u1 = glyph->U0;
+                            const float v1 = glyph->V0;
+                            const float u2 = glyph->U1;
+                            const float v2 = glyph->V1;
+                            idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                            idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                            vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
+                            vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
+                            vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
+                            vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                            vtx_write += 4;
+                            vtx_current_idx += 4;
+                            idx_write += 6;
+                        }
+                    }
+                    x += char_width;
+                }
+            }
+            continue;
+        }
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -406,6 +406,10 @@ IMGUI_API ImVec2     ImTriangleClosestPoint(const ImVec2& a, const ImVec2& b, co
 IMGUI_API void       ImTriangleBarycentricCoords(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& p, float& out_u, float& out_v, float& out_w);
 inline float         ImTriangleArea(const ImVec2& a, const ImVec2& b, const ImVec2& c) { return ImFabs((a.x * (b.y - c.y)) + (b.x * (c.y - a.y)) + (c.x * (a.y - b.y))) * 0.5f; }
 IMGUI_API ImGuiDir   ImGetDirQuadrantFromDelta(float dx, float dy);
+IMGUI_API void       ImComputeSegmentNormals(const ImVec2* points, int points_count, int segments_count, ImVec2* out_normals);         // [UnrealImGui] Normal kernels of AddPolyline() and AddConvexPolyFilled(), SSE2/NEON with IMGUI_SIMD_TESSELLATION
+IMGUI_API void       ImComputeSegmentNormalsScalar(const ImVec2* points, int points_count, int segments_count, ImVec2* out_normals);   // [UnrealImGui] Same results without SSE2/NEON, for tests
+IMGUI_API void       ImComputeAveragedNormals(const ImVec2* normals, int points_count, ImVec2* out_normals);                          // [UnrealImGui]
+IMGUI_API void       ImComputeAveragedNormalsScalar(const ImVec2* normals, int points_count, ImVec2* out_normals);                    // [UnrealImGui]
 
 // Helper: ImVec1 (1D vector)
 // (this odd construct is used to facilitate the transition between 1D and 2D, and the maintenance of some branches/patches)
@@ -647,6 +651,25 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// [UnrealImGui] Glyph quads RenderText() emitted for a label, replayed at another position while the text, font and size stay the same.
+// Quads are only recorded and replayed while the layout fits inside the clip rect, where ImFont::RenderText() culls nothing.
+struct ImGuiTextCacheEntry
+{
+    const ImFont*           Font;
+    float                   FontSize;
+    float                   WrapWidth;
+    int                     FontGlyphsGeneration;   // ImFont::GlyphsGeneration when recorded
+    ImVector<char>          Text;                   // Compared on lookup, as different labels may share a key
+    int                     LastFrameUsed;
+    bool                    SeenBefore;             // Labels are recorded the second time they are drawn, most one-off strings never are
+    bool                    Recorded;
+    ImVec2                  LayoutMin, LayoutMax;   // Relative to the pixel aligned text position
+    ImVector<ImDrawVert>    Vertices;               // 4 per glyph with relative positions, the color is set on replay
+    ImVector<int>           GlyphIndices;           // Stamped on replay while a GlyphLoader manages the font
+
+    ImGuiTextCacheEntry()   { Font = NULL; FontSize = WrapWidth = 0.0f; FontGlyphsGeneration = LastFrameUsed = -1; SeenBefore = Recorded = false; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Widgets support: flags, enums, data structures
 //-----------------------------------------------------------------------------
@@ -1000,7 +1023,8 @@ enum ImGuiNextWindowDataFlags_
     ImGuiNextWindowDataFlags_HasSizeConstraint  = 1 << 4,
     ImGuiNextWindowDataFlags_HasFocus           = 1 << 5,
     ImGuiNextWindowDataFlags_HasBgAlpha         = 1 << 6,
-    ImGuiNextWindowDataFlags_HasScroll          = 1 << 7
+    ImGuiNextWindowDataFlags_HasScroll          = 1 << 7,
+    ImGuiNextWindowDataFlags_HasContentHash     = 1 << 8    // [UnrealImGui]
 };
 
 // Storage for SetNexWindow** functions
@@ -1020,6 +1044,7 @@ struct ImGuiNextWindowData
     ImGuiSizeCallback           SizeCallback;
     void*                       SizeCallbackUserData;
     float                       BgAlphaVal;             // Override background alpha
+    ImGuiID                     ContentHashVal;         // [UnrealImGui] See ImGuiWindowFlags_Retained
     ImVec2                      MenuBarOffsetMinVal;    // *Always on* This is not exposed publicly, so we don't clear it.
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
@@ -1380,6 +1405,7 @@ struct ImGuiContext
     // Render
     ImDrawData              DrawData;                           // Main ImDrawData instance to pass render information to the user
     ImDrawDataBuilder       DrawDataBuilder;
+    ImVector<ImDrawList*>   DrawListsToTessellate;              // [UnrealImGui] Draw lists with deferred shapes, one job each in Render()
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
     ImDrawList              BackgroundDrawList;                 // First draw list to be rendered.
     ImDrawList              ForegroundDrawList;                 // Last draw list to be rendered. This is where we the render software mouse cursor (if io.MouseDrawCursor is set) and most debug overlays.
@@ -1417,6 +1443,15 @@ struct ImGuiContext
     ImVector<ImGuiPtrOrIndex>       CurrentTabBarStack;
     ImVector<ImGuiShrinkWidthItem>  ShrinkWidthBuffer;
 
+    // [UnrealImGui] Text cache (see RenderText())
+    bool                            TextCacheEnabled;
+    ImPool<ImGuiTextCacheEntry>     TextCache;                  // Keyed by a hash of the text, font, size and wrap width
+    int                             TextCacheHits, TextCacheMisses;                     // This frame
+    int                             TextCacheHitsLastFrame, TextCacheMissesLastFrame;
+
+    // [UnrealImGui] Retained windows (see ImGuiWindowFlags_Retained)
+    ImGuiID                         RetainedFrameHash;          // Hash of the style and fonts, part of every ImGuiWindow::RetainedHash
+
     // Widget state
     ImVec2                  LastValidMousePos;
     ImGuiInputTextState     InputTextState;
@@ -1585,6 +1620,11 @@ struct ImGuiContext
         CurrentTable = NULL;
         CurrentTabBar = NULL;
 
+        TextCacheEnabled = true;
+        TextCacheHits = TextCacheMisses = 0;
+        TextCacheHitsLastFrame = TextCacheMissesLastFrame = 0;
+        RetainedFrameHash = 0;
+
         LastValidMousePos = ImVec2(0.0f, 0.0f);
         TempInputId = 0;
         ColorEditOptions = ImGuiColorEditFlags__OptionsDefault;
@@ -1777,6 +1817,20 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
 
+    // [UnrealImGui] ImGuiWindowFlags_Retained
+    ImGuiID                 RetainedContentHash;                // Set by SetNextWindowContentHash() for this frame
+    ImGuiID                 RetainedHash;                       // Hash of everything the recorded draw list depends on, 0 when it can't be reused
+    bool                    RetainedThisFrame;                  // Contents were skipped and the recorded draw list is restored in End()
+    ImVec2                  RetainedCursorMaxPos;               // DC.CursorMaxPos/DC.IdealMaxPos of the recorded frame, restored so ContentSize stays the same
+    ImVec2                  RetainedIdealMaxPos;
+    ImDrawCmdHeader         RetainedCmdHeader;
+    unsigned int            RetainedVtxCurrentIdx;
+    ImVector<ImDrawCmd>     RetainedCmdBuffer;                  // Copy of DrawList at the End() of the recorded frame
+    ImVector<ImDrawIdx>     RetainedIdxBuffer;
+    ImVector<ImDrawVert>    RetainedVtxBuffer;
+    ImVector<ImFontGlyphRef> RetainedGlyphs;                    // Glyphs stamped while the draw list was recorded, kept alive while it is replayed
+    ImVector<ImFontGlyphRef>* RetainedParentGlyphsUseLog;       // ImFontAtlas::GlyphsUseLog to restore once RetainedGlyphs is logged
+
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
     ~ImGuiWindow();
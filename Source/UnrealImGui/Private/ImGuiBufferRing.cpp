@@ -0,0 +1,198 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiBufferRing.h"
+#include "ImGuiStats.h"
+#include "UnrealImGui.h"
+
+namespace UnrealImGui
+{
+	static int32 GBufferRingSize = 3;
+	static FAutoConsoleVariableRef CVarBufferRingSize = FAutoConsoleVariableRef(
+		TEXT("imgui.buffer.ringsize"),
+		GBufferRingSize,
+		TEXT("Number of ImGui vertex/index buffer sets cycled between frames (1-8)\n")
+		TEXT("Higher values avoid waiting on the GPU at the cost of more memory"),
+		ECVF_RenderThreadSafe
+	);
+
+	static int32 GBufferShrinkFrames = 600;
+	static FAutoConsoleVariableRef CVarBufferShrinkFrames = FAutoConsoleVariableRef(
+		TEXT("imgui.buffer.shrinkframes"),
+		GBufferShrinkFrames,
+		TEXT("Number of consecutive frames an ImGui buffer has to stay below a quarter of its size before it is shrunk\n")
+		TEXT("0: Never shrink"),
+		ECVF_RenderThreadSafe
+	);
+
+	//Smallest size we'll ever allocate, so tiny frames don't cause a string of small reallocations
+	static constexpr uint32 MinBufferSize = 64 * 1024;
+}
+
+UnrealImGui::FImGuiBufferRing::FSlot& UnrealImGui::FImGuiBufferRing::Acquire(uint32 VertexBytes, uint32 IndexBytes, uint32 AuxVertexBytes, uint32 PrimitiveBytes)
+{
+	check(IsInRenderingThread());
+
+	const int32 NumSlots = FMath::Clamp(GBufferRingSize, 1, 8);
+	if (Slots.Num() != NumSlots)
+	{
+		Reset();
+		Slots.SetNum(NumSlots);
+	}
+
+	//Find the next slot whose previous draws have completed on the GPU
+	int32 SlotIndex = INDEX_NONE;
+	for (int32 Attempt = 0; Attempt < NumSlots; ++Attempt)
+	{
+		const int32 CandidateIndex = (CurrentSlot + 1 + Attempt) % NumSlots;
+		const FGPUFenceRHIRef& Fence = Slots[CandidateIndex].Fence;
+		if (!Fence.IsValid() || Fence->Poll())
+		{
+			SlotIndex = CandidateIndex;
+			break;
+		}
+	}
+
+	//Everything is still in flight. Take the oldest slot, the RHI will rename or wait on the buffer when we lock it.
+	if (SlotIndex == INDEX_NONE)
+	{
+		SlotIndex = (CurrentSlot + 1) % NumSlots;
+		INC_DWORD_STAT(STAT_ImGuiBufferRingStalls);
+	}
+	CurrentSlot = SlotIndex;
+
+	FSlot& Slot = Slots[SlotIndex];
+	Slot.ContentHash = 0;
+	Slot.bPackedVertices = false;
+	UpdateBuffer(Slot.VertexBuffer, VertexBytes, false, TEXT("ImGuiVertexBuffer"));
+	UpdateBuffer(Slot.IndexBuffer, IndexBytes, true, TEXT("ImGuiIndexBuffer"));
+	if (AuxVertexBytes > 0 || Slot.AuxVertexBuffer.BufferRHI.IsValid())
+	{
+		UpdateBuffer(Slot.AuxVertexBuffer, AuxVertexBytes, false, TEXT("ImGuiAuxVertexBuffer"));
+	}
+	if (PrimitiveBytes > 0 || Slot.PrimitiveBuffer.BufferRHI.IsValid())
+	{
+		UpdateBuffer(Slot.PrimitiveBuffer, PrimitiveBytes, false, TEXT("ImGuiPrimitiveBuffer"));
+	}
+	return Slot;
+}
+
+UnrealImGui::FImGuiBufferRing::FSlot* UnrealImGui::FImGuiBufferRing::FindUploaded(uint64 ContentHash)
+{
+	check(IsInRenderingThread());
+
+	//Changing the ring size resets every slot on the next Acquire
+	if (ContentHash == 0 || !Slots.IsValidIndex(CurrentSlot) || Slots.Num() != FMath::Clamp(GBufferRingSize, 1, 8))
+	{
+		return nullptr;
+	}
+	FSlot& Slot = Slots[CurrentSlot];
+	return Slot.ContentHash == ContentHash ? &Slot : nullptr;
+}
+
+UnrealImGui::FImGuiBufferRing::FSlotRef UnrealImGui::FImGuiBufferRing::MakeRef(const FSlot& Slot) const
+{
+	FSlotRef Ref;
+	Ref.VertexBuffer = Slot.VertexBuffer.BufferRHI;
+	Ref.AuxVertexBuffer = Slot.AuxVertexBuffer.BufferRHI;
+	Ref.PrimitiveBuffer = Slot.PrimitiveBuffer.BufferRHI;
+	Ref.IndexBuffer = Slot.IndexBuffer.BufferRHI;
+	Ref.bPackedVertices = Slot.bPackedVertices;
+	Ref.SlotIndex = static_cast<int32>(&Slot - Slots.GetData());
+	Ref.ResetCount = ResetCount;
+	check(Slots.IsValidIndex(Ref.SlotIndex));
+	return Ref;
+}
+
+void UnrealImGui::FImGuiBufferRing::Release(FRHICommandListImmediate& RHICmdList, const FSlotRef& Ref)
+{
+	//The slot's buffers were released by a reset, and Ref kept the ones the draws used alive
+	if (Ref.ResetCount != ResetCount || !Slots.IsValidIndex(Ref.SlotIndex))
+	{
+		return;
+	}
+
+	FSlot& Slot = Slots[Ref.SlotIndex];
+	if (!Slot.Fence.IsValid())
+	{
+		Slot.Fence = RHICreateGPUFence(TEXT("ImGuiBufferRingFence"));
+	}
+	Slot.Fence->Clear();
+	RHICmdList.WriteGPUFence(Slot.Fence);
+}
+
+void UnrealImGui::FImGuiBufferRing::Reset()
+{
+	for (FSlot& Slot : Slots)
+	{
+		ReleaseBuffer(Slot.VertexBuffer);
+		ReleaseBuffer(Slot.AuxVertexBuffer);
+		ReleaseBuffer(Slot.PrimitiveBuffer);
+		ReleaseBuffer(Slot.IndexBuffer);
+		Slot.Fence = nullptr;
+	}
+	Slots.Reset();
+	CurrentSlot = INDEX_NONE;
+	++ResetCount;
+}
+
+void UnrealImGui::FImGuiBufferRing::UpdateBuffer(FBuffer& Buffer, uint32 RequiredBytes, bool bIndexBuffer, const TCHAR* DebugName)
+{
+	uint32 NewSize = Buffer.Size;
+	if (!Buffer.BufferRHI.IsValid() || RequiredBytes > Buffer.Size)
+	{
+		//Grow geometrically so a slowly growing UI doesn't reallocate every frame
+		NewSize = FMath::RoundUpToPowerOfTwo(FMath::Max3(RequiredBytes, Buffer.Size + Buffer.Size / 2, MinBufferSize));
+		Buffer.IdleFrames = 0;
+	}
+	else if (RequiredBytes < Buffer.Size / 4 && Buffer.Size > MinBufferSize)
+	{
+		++Buffer.IdleFrames;
+		if (GBufferShrinkFrames > 0 && Buffer.IdleFrames >= static_cast<uint32>(GBufferShrinkFrames))
+		{
+			//Keep some headroom over the current usage
+			NewSize = FMath::RoundUpToPowerOfTwo(FMath::Max(RequiredBytes * 2, MinBufferSize));
+			Buffer.IdleFrames = 0;
+		}
+	}
+	else
+	{
+		Buffer.IdleFrames = 0;
+	}
+
+	if (NewSize == Buffer.Size && Buffer.BufferRHI.IsValid())
+	{
+		return;
+	}
+
+	ReleaseBuffer(Buffer);
+
+	FRHIResourceCreateInfo BufferCreateInfo(DebugName);
+	if (bIndexBuffer)
+	{
+		Buffer.BufferRHI = RHICreateIndexBuffer(sizeof(ImDrawIdx), NewSize, BUF_Dynamic, BufferCreateInfo);
+	}
+	else
+	{
+		Buffer.BufferRHI = RHICreateVertexBuffer(NewSize, BUF_Dynamic, BufferCreateInfo);
+	}
+	Buffer.Size = NewSize;
+
+	AllocatedBytes += NewSize;
+	PeakBytes = FMath::Max(PeakBytes, AllocatedBytes);
+
+	INC_DWORD_STAT(STAT_ImGuiBufferReallocations);
+	INC_MEMORY_STAT_BY(STAT_ImGuiBufferMemory, NewSize);
+	SET_MEMORY_STAT(STAT_ImGuiBufferPeakMemory, PeakBytes);
+}
+
+void UnrealImGui::FImGuiBufferRing::ReleaseBuffer(FBuffer& Buffer)
+{
+	if (Buffer.BufferRHI.IsValid())
+	{
+		DEC_MEMORY_STAT_BY(STAT_ImGuiBufferMemory, Buffer.Size);
+		AllocatedBytes -= Buffer.Size;
+	}
+	Buffer.BufferRHI = nullptr;
+	Buffer.Size = 0;
+	Buffer.IdleFrames = 0;
+}
@@ -0,0 +1,73 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHI.h"
+#include "RHIResources.h"
+
+namespace UnrealImGui
+{
+	//Persistent vertex/index buffers for the ImGui pass.
+	//Buffers live in a small ring so we can write the next frame while the GPU may still be reading a previous one.
+	//Buffers only reallocate when a frame doesn't fit (growing geometrically), and shrink back after being mostly unused for a while.
+	class FImGuiBufferRing
+	{
+	public:
+		struct FBuffer
+		{
+			FBufferRHIRef BufferRHI;
+			uint32 Size = 0;
+			uint32 IdleFrames = 0; //Consecutive frames that used less than a quarter of Size
+		};
+
+		struct FSlot
+		{
+			FBuffer VertexBuffer;
+			FBuffer AuxVertexBuffer; //Only allocated when a frame needs a second vertex stream
+			FBuffer PrimitiveBuffer; //Only allocated when a frame has GPU primitives (per instance stream)
+			FBuffer IndexBuffer;
+			FGPUFenceRHIRef Fence; //Written once the GPU is done with this slot's draws
+			uint64 ContentHash = 0; //FUnrealImGuiDrawData::ContentHash of the data uploaded into the buffers, 0 if unknown
+			bool bPackedVertices = false; //VertexBuffer holds FUnrealImGuiPackedVertex instead of ImDrawVert
+		};
+
+		//Copy of what the passes drawing from a slot need, safe to capture in RDG pass lambdas.
+		//Slots is reallocated when imgui.buffer.ringsize changes, so references to an FSlot mustn't outlive the call that returned them.
+		struct FSlotRef
+		{
+			FBufferRHIRef VertexBuffer;
+			FBufferRHIRef AuxVertexBuffer;
+			FBufferRHIRef PrimitiveBuffer;
+			FBufferRHIRef IndexBuffer;
+			bool bPackedVertices = false;
+			int32 SlotIndex = INDEX_NONE;
+			uint32 ResetCount = 0; //FImGuiBufferRing::ResetCount when the ref was made
+		};
+
+		//Picks the next slot the GPU is done with and makes sure it can hold the requested amount of data
+		FSlot& Acquire(uint32 VertexBytes, uint32 IndexBytes, uint32 AuxVertexBytes = 0, uint32 PrimitiveBytes = 0);
+
+		//Returns the last slot returned by Acquire if its buffers still hold the data uploaded with ContentHash, so an unchanged frame can draw from them again
+		FSlot* FindUploaded(uint64 ContentHash);
+
+		//Returns a copy of Slot's buffer references, which keeps them alive even if the ring resets
+		FSlotRef MakeRef(const FSlot& Slot) const;
+
+		//Marks the slot Ref was made from as in flight. Call after all draws reading it have been submitted. Does nothing if the ring was reset since.
+		void Release(FRHICommandListImmediate& RHICmdList, const FSlotRef& Ref);
+
+		//Releases all buffers
+		void Reset();
+
+	private:
+		void UpdateBuffer(FBuffer& Buffer, uint32 RequiredBytes, bool bIndexBuffer, const TCHAR* DebugName);
+		void ReleaseBuffer(FBuffer& Buffer);
+
+		TArray<FSlot> Slots;
+		int32 CurrentSlot = INDEX_NONE;
+		uint32 ResetCount = 0;
+		uint64 AllocatedBytes = 0;
+		uint64 PeakBytes = 0;
+	};
+}
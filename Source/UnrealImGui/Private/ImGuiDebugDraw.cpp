@@ -0,0 +1,277 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiDebugDraw.h"
+#include "ImGuiStats.h"
+
+namespace UnrealImGui
+{
+	static int32 GDebugDrawMaxPendingKB = 4096;
+	static FAutoConsoleVariableRef CVarDebugDrawMaxPendingKB = FAutoConsoleVariableRef(
+		TEXT("imgui.debugdraw.maxpendingkb"),
+		GDebugDrawMaxPendingKB,
+		TEXT("Most debug draw data (in KB) a single thread can have waiting for the game thread, further primitives are dropped\n")
+		TEXT("Bounds memory while nothing drains the queues, e.g. while ImGui is hidden and the viewport isn't rendered"),
+		ECVF_Default
+	);
+
+	//Longest text primitive, in UTF-8 bytes
+	static constexpr int32 MaxDebugDrawTextLength = 1024;
+
+	//Smallest clip space W the World* primitives are projected with, anything closer is behind the camera or too close to place
+	static constexpr double DebugDrawMinClipW = 1.0e-3;
+}
+
+struct UnrealImGui::FImGuiDebugDrawQueue::FChunk
+{
+	static constexpr uint32 Capacity = 16 * 1024;
+
+	std::atomic<FChunk*> Next { nullptr };		//Set by the writer once it's done with this chunk
+	std::atomic<uint32> Committed { 0 };		//Bytes the writer finished writing
+	uint32 Used = 0;							//Writer only
+	alignas(FImGuiDebugDrawCommand) uint8 Data[Capacity];
+};
+
+struct UnrealImGui::FImGuiDebugDrawQueue::FThreadQueue
+{
+	FThreadQueue* NextQueue = nullptr;			//Never changes once the queue is published
+	FChunk* WriteChunk = nullptr;				//Writer only
+	FChunk* ReadChunk = nullptr;				//Game thread only
+	uint32 ReadOffset = 0;						//Game thread only
+	std::atomic<int32> NumChunks { 1 };
+	std::atomic<uint32> NumDropped { 0 };
+	std::atomic<bool> bAbandoned { false };		//Its thread exited, the next new thread takes it over
+};
+
+UnrealImGui::FImGuiDebugDrawQueue::FThreadQueue& UnrealImGui::FImGuiDebugDrawQueue::GetThreadQueue()
+{
+	//Gives the queue up when its thread exits, so short-lived threads don't each leave one behind
+	struct FLocalQueue
+	{
+		~FLocalQueue()
+		{
+			if (Queue != nullptr)
+			{
+				Queue->bAbandoned.store(true, std::memory_order_release);
+			}
+		}
+		FThreadQueue* Queue = nullptr;
+	};
+	thread_local FLocalQueue LocalQueue;
+	if (LocalQueue.Queue != nullptr)
+	{
+		return *LocalQueue.Queue;
+	}
+
+	//Take over the queue of a thread that exited. What it wrote happened before it was abandoned, so we can keep appending to its chunk.
+	FThreadQueue* Queue = ThreadQueues.load(std::memory_order_acquire);
+	for (; Queue != nullptr; Queue = Queue->NextQueue)
+	{
+		bool bExpected = true;
+		if (Queue->bAbandoned.load(std::memory_order_relaxed) && Queue->bAbandoned.compare_exchange_strong(bExpected, false, std::memory_order_acquire))
+		{
+			break;
+		}
+	}
+
+	if (Queue == nullptr)
+	{
+		Queue = new FThreadQueue();
+		Queue->WriteChunk = Queue->ReadChunk = new FChunk();
+		FThreadQueue* Head = ThreadQueues.load(std::memory_order_relaxed);
+		do
+		{
+			Queue->NextQueue = Head;
+		}
+		while (!ThreadQueues.compare_exchange_weak(Head, Queue, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	LocalQueue.Queue = Queue;
+	return *Queue;
+}
+
+void UnrealImGui::FImGuiDebugDrawQueue::Add(const FImGuiDebugDrawCommand& Command, FStringView Text)
+{
+	if (!bEnabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	FTCHARToUTF8 Utf8Text(Text.GetData(), Text.Len());
+	int32 TextLength = FMath::Min(Utf8Text.Length(), MaxDebugDrawTextLength);
+	//Don't cut a truncated string in the middle of a character
+	while (TextLength < Utf8Text.Length() && TextLength > 0 && (Utf8Text.Get()[TextLength] & 0xC0) == 0x80)
+	{
+		--TextLength;
+	}
+	const uint32 Size = Align(static_cast<uint32>(sizeof(FImGuiDebugDrawCommand) + TextLength), static_cast<uint32>(alignof(FImGuiDebugDrawCommand)));
+
+	FThreadQueue& Queue = GetThreadQueue();
+	FChunk* Chunk = Queue.WriteChunk;
+	if (Chunk->Used + Size > FChunk::Capacity)
+	{
+		//At least two: the game thread only frees a drained chunk once the next one exists, a single chunk would never be written again
+		const int32 MaxChunks = FMath::Max(2, static_cast<int32>((static_cast<int64>(GDebugDrawMaxPendingKB) * 1024) / FChunk::Capacity));
+		if (Queue.NumChunks.load(std::memory_order_relaxed) >= MaxChunks)
+		{
+			Queue.NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		FChunk* NewChunk = new FChunk();
+		Queue.NumChunks.fetch_add(1, std::memory_order_relaxed);
+		//Chunk's last Committed store happened before this, so the game thread sees all of it once it sees Next
+		Chunk->Next.store(NewChunk, std::memory_order_release);
+		Queue.WriteChunk = Chunk = NewChunk;
+	}
+
+	uint8* Dest = Chunk->Data + Chunk->Used;
+	FImGuiDebugDrawCommand* Written = new (Dest) FImGuiDebugDrawCommand(Command);
+	Written->TextLength = static_cast<uint16>(TextLength);
+	if (TextLength > 0)
+	{
+		FMemory::Memcpy(Dest + sizeof(FImGuiDebugDrawCommand), Utf8Text.Get(), TextLength);
+	}
+	Chunk->Used += Size;
+	Chunk->Committed.store(Chunk->Used, std::memory_order_release);
+}
+
+void UnrealImGui::FImGuiDebugDrawQueue::SetEnabled(bool bInEnabled)
+{
+	check(IsInGameThread());
+	bEnabled.store(bInEnabled, std::memory_order_relaxed);
+	Discard();
+}
+
+void UnrealImGui::FImGuiDebugDrawQueue::Consume(TFunctionRef<void(const FImGuiDebugDrawCommand&, const char*)> Visitor)
+{
+	check(IsInGameThread());
+
+	uint32 NumDropped = 0;
+	for (FThreadQueue* Queue = ThreadQueues.load(std::memory_order_acquire); Queue != nullptr; Queue = Queue->NextQueue)
+	{
+		FChunk* Chunk = Queue->ReadChunk;
+		for (;;)
+		{
+			//Next first: once it's set, Committed is final
+			FChunk* Next = Chunk->Next.load(std::memory_order_acquire);
+			const uint32 Committed = Chunk->Committed.load(std::memory_order_acquire);
+			while (Queue->ReadOffset < Committed)
+			{
+				const FImGuiDebugDrawCommand& Command = *reinterpret_cast<const FImGuiDebugDrawCommand*>(Chunk->Data + Queue->ReadOffset);
+				Visitor(Command, reinterpret_cast<const char*>(&Command + 1));
+				Queue->ReadOffset += Align(static_cast<uint32>(sizeof(FImGuiDebugDrawCommand) + Command.TextLength), static_cast<uint32>(alignof(FImGuiDebugDrawCommand)));
+			}
+			if (Next == nullptr)
+			{
+				break;
+			}
+
+			delete Chunk;
+			Queue->NumChunks.fetch_sub(1, std::memory_order_relaxed);
+			Chunk = Next;
+			Queue->ReadOffset = 0;
+		}
+		Queue->ReadChunk = Chunk;
+		NumDropped += Queue->NumDropped.exchange(0, std::memory_order_relaxed);
+	}
+	INC_DWORD_STAT_BY(STAT_ImGuiDebugDrawDropped, NumDropped);
+}
+
+static ImVec2 ToImVec2(const FVector& Position)
+{
+	return ImVec2(static_cast<float>(Position.X), static_cast<float>(Position.Y));
+}
+
+//Same mapping as FSceneView::ProjectWorldToScreen, for a point in front of the near plane
+static ImVec2 ClipToViewport(const UnrealImGui::FImGuiDebugDrawView& View, const FVector4& ClipPosition)
+{
+	const double InvW = 1.0 / ClipPosition.W;
+	const double X = View.ViewRect.Min.X + (0.5 + ClipPosition.X * InvW * 0.5) * View.ViewRect.Width();
+	const double Y = View.ViewRect.Min.Y + (0.5 - ClipPosition.Y * InvW * 0.5) * View.ViewRect.Height();
+	return ImVec2(static_cast<float>(X), static_cast<float>(Y));
+}
+
+void UnrealImGui::FImGuiDebugDrawQueue::Drain(ImDrawList* Background, ImDrawList* Foreground, const FImGuiDebugDrawView* View)
+{
+	uint32 NumPrimitives = 0;
+	Consume([Background, Foreground, View, &NumPrimitives](const FImGuiDebugDrawCommand& Command, const char* Text)
+	{
+		ImDrawList* DrawList = Command.Layer == EImGuiDebugDrawLayer::Foreground ? Foreground : Background;
+		++NumPrimitives;
+		switch (Command.Type)
+		{
+			case EImGuiDebugDrawType::Line:
+				AddLine(DrawList, ToImVec2(Command.P0), ToImVec2(Command.P1), Command.Col, Command.Thickness);
+				break;
+			case EImGuiDebugDrawType::Rect:
+				DrawList->AddRect(ToImVec2(Command.P0), ToImVec2(Command.P1), Command.Col, 0.0f, ImDrawCornerFlags_All, Command.Thickness);
+				break;
+			case EImGuiDebugDrawType::RectFilled:
+				DrawList->AddRectFilled(ToImVec2(Command.P0), ToImVec2(Command.P1), Command.Col);
+				break;
+			case EImGuiDebugDrawType::Circle:
+				AddCircle(DrawList, ToImVec2(Command.P0), Command.Size, Command.Col, Command.Thickness);
+				break;
+			case EImGuiDebugDrawType::CircleFilled:
+				AddCircleFilled(DrawList, ToImVec2(Command.P0), Command.Size, Command.Col);
+				break;
+			case EImGuiDebugDrawType::Text:
+				DrawList->AddText(ToImVec2(Command.P0), Command.Col, Text, Text + Command.TextLength);
+				break;
+			case EImGuiDebugDrawType::WorldPoint:
+			case EImGuiDebugDrawType::WorldText:
+			{
+				if (View == nullptr)
+				{
+					break;
+				}
+				const FVector4 ClipPosition = View->ViewProjectionMatrix.TransformFVector4(FVector4(Command.P0, 1.0));
+				if (ClipPosition.W < DebugDrawMinClipW)
+				{
+					break;
+				}
+				const ImVec2 Position = ClipToViewport(*View, ClipPosition);
+				if (Command.Type == EImGuiDebugDrawType::WorldText)
+				{
+					DrawList->AddText(Position, Command.Col, Text, Text + Command.TextLength);
+				}
+				else
+				{
+					const float HalfSize = Command.Size * 0.5f;
+					DrawList->AddRectFilled(ImVec2(Position.x - HalfSize, Position.y - HalfSize), ImVec2(Position.x + HalfSize, Position.y + HalfSize), Command.Col);
+				}
+				break;
+			}
+			case EImGuiDebugDrawType::WorldLine:
+			{
+				if (View == nullptr)
+				{
+					break;
+				}
+				FVector4 Start = View->ViewProjectionMatrix.TransformFVector4(FVector4(Command.P0, 1.0));
+				FVector4 End = View->ViewProjectionMatrix.TransformFVector4(FVector4(Command.P1, 1.0));
+				if (Start.W < DebugDrawMinClipW && End.W < DebugDrawMinClipW)
+				{
+					break;
+				}
+				//Clip against the near plane in clip space, where the segment is still straight
+				if (Start.W < DebugDrawMinClipW)
+				{
+					Start = Start + (End - Start) * ((DebugDrawMinClipW - Start.W) / (End.W - Start.W));
+				}
+				else if (End.W < DebugDrawMinClipW)
+				{
+					End = End + (Start - End) * ((DebugDrawMinClipW - End.W) / (Start.W - End.W));
+				}
+				AddLine(DrawList, ClipToViewport(*View, Start), ClipToViewport(*View, End), Command.Col, Command.Thickness);
+				break;
+			}
+		}
+	});
+	INC_DWORD_STAT_BY(STAT_ImGuiDebugDrawPrimitives, NumPrimitives);
+}
+
+void UnrealImGui::FImGuiDebugDrawQueue::Discard()
+{
+	Consume([](const FImGuiDebugDrawCommand&, const char*) {});
+}
@@ -0,0 +1,74 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealImGui.h"
+#include <atomic>
+
+namespace UnrealImGui
+{
+	enum class EImGuiDebugDrawType : uint8
+	{
+		Line,			//P0 to P1, in viewport pixels
+		Rect,			//P0 (min) to P1 (max)
+		RectFilled,
+		Circle,			//Centered on P0
+		CircleFilled,
+		Text,			//Top left at P0
+		WorldPoint,		//Square of Size pixels centered on P0 once projected
+		WorldLine,		//P0 to P1, clipped to the near plane once projected
+		WorldText,		//Top left at P0 once projected
+	};
+
+	//A queued debug primitive. Text primitives are followed by TextLength bytes of UTF-8.
+	struct FImGuiDebugDrawCommand
+	{
+		FVector P0;
+		FVector P1;
+		float Size;			//Radius of circles, size of points
+		float Thickness;
+		ImU32 Col;
+		EImGuiDebugDrawType Type;
+		EImGuiDebugDrawLayer Layer;
+		uint16 TextLength;
+	};
+
+	//How the World* primitives are projected to viewport pixels
+	struct FImGuiDebugDrawView
+	{
+		FIntRect ViewRect;
+		FMatrix ViewProjectionMatrix;
+	};
+
+	//Any Thread: Debug primitives waiting to be drawn by the game thread.
+	//Each thread appends to a queue of its own, a list of chunks it publishes with a release store after every primitive, so writers never wait
+	//on each other or on the game thread, and the game thread can drain at any time. Drained chunks are freed once their thread moved on to the next one.
+	//Meant to be a single global: threads find their queue through a thread_local. Thread queues are never freed, threads may outlive the global.
+	class FImGuiDebugDrawQueue
+	{
+	public:
+		//Any Thread: Queues Command, and Text for text primitives. Dropped when not enabled, or when this thread has imgui.debugdraw.maxpendingkb queued already.
+		void Add(const FImGuiDebugDrawCommand& Command, FStringView Text = FStringView());
+
+		//Game Thread: Starts or stops accepting primitives, discarding what's queued
+		void SetEnabled(bool bInEnabled);
+
+		//Game Thread: Draws everything queued so far into Background or Foreground, depending on its layer.
+		//World primitives are skipped without a View.
+		void Drain(ImDrawList* Background, ImDrawList* Foreground, const FImGuiDebugDrawView* View);
+
+		//Game Thread: Forgets everything queued so far
+		void Discard();
+
+	private:
+		struct FChunk;
+		struct FThreadQueue;
+
+		FThreadQueue& GetThreadQueue();
+		void Consume(TFunctionRef<void(const FImGuiDebugDrawCommand&, const char*)> Visitor);
+
+		std::atomic<FThreadQueue*> ThreadQueues { nullptr };
+		std::atomic<bool> bEnabled { false };
+	};
+}
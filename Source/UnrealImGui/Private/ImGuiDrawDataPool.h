@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealImGui.h"
+#include <atomic>
+
+namespace UnrealImGui
+{
+	//Recycles FUnrealImGuiDrawData snapshots between the game and render thread.
+	//The game thread fills a free snapshot and hands it to the render thread, which gives it back once it's done with it.
+	//The render thread holds on to the newest snapshot until the next one arrives, to redraw it for frames that didn't change.
+	//Snapshots keep their allocations, so once the pool has warmed up, frames don't allocate.
+	class FImGuiDrawDataPool
+	{
+	public:
+		FImGuiDrawDataPool()
+		{
+			//Triple buffered by default, more snapshots get added if the render thread falls further behind
+			for (int32 i = 0; i < 3; ++i)
+			{
+				DrawDataSnapshots.Add(MakeUnique<FPooledDrawData>());
+			}
+		}
+
+		//Game Thread: Returns a snapshot that isn't in use by the render thread
+		FUnrealImGuiDrawData* Acquire()
+		{
+			check(IsInGameThread());
+			for (const TUniquePtr<FPooledDrawData>& Snapshot : DrawDataSnapshots)
+			{
+				if (!Snapshot->bInFlight.load(std::memory_order_acquire))
+				{
+					Snapshot->bInFlight.store(true, std::memory_order_relaxed);
+					return Snapshot.Get();
+				}
+			}
+
+			FPooledDrawData* NewSnapshot = DrawDataSnapshots.Add_GetRef(MakeUnique<FPooledDrawData>()).Get();
+			NewSnapshot->bInFlight.store(true, std::memory_order_relaxed);
+			return NewSnapshot;
+		}
+
+		//Render Thread: Hands a snapshot returned by Acquire back to the game thread
+		static void Release(FUnrealImGuiDrawData* DrawData)
+		{
+			static_cast<FPooledDrawData*>(DrawData)->bInFlight.store(false, std::memory_order_release);
+		}
+
+	private:
+		struct FPooledDrawData : FUnrealImGuiDrawData
+		{
+			std::atomic<bool> bInFlight { false };
+		};
+
+		TArray<TUniquePtr<FPooledDrawData>> DrawDataSnapshots;
+	};
+}
@@ -0,0 +1,351 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiFontAtlasCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+#if WITH_IMGUI_FREETYPE
+#include "ThirdParty/ImGui/misc/freetype/imgui_freetype.h"
+#endif
+
+namespace UnrealImGui
+{
+	//Bump when the file layout or anything baked into it changes
+	static constexpr uint32 FontAtlasCacheMagic = 0x41464D49; //"IMFA"
+	static constexpr uint32 FontAtlasCacheVersion = 2;
+
+	//Output of a font atlas build, everything ImGui needs at runtime
+	struct FCachedFont
+	{
+		float FontSize = 0.0f;
+		float Ascent = 0.0f;
+		float Descent = 0.0f;
+		int32 MetricsTotalSurface = 0;
+		uint32 FallbackChar = 0;
+		uint32 EllipsisChar = 0;
+		TArray<ImFontGlyph> Glyphs;
+	};
+
+	struct FCachedFontAtlas
+	{
+		int32 TexWidth = 0;
+		int32 TexHeight = 0;
+		ImVec2 TexUvWhitePixel;
+		ImVec4 TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+		TArray<FIntPoint> CustomRectPositions;
+		TArray<FCachedFont> Fonts;
+		TArray<uint8> Pixels;
+	};
+
+	static FArchive& operator<<(FArchive& Ar, ImVec2& Value)
+	{
+		return Ar << Value.x << Value.y;
+	}
+
+	static FArchive& operator<<(FArchive& Ar, ImVec4& Value)
+	{
+		return Ar << Value.x << Value.y << Value.z << Value.w;
+	}
+
+	static FArchive& operator<<(FArchive& Ar, FCachedFont& Font)
+	{
+		Ar << Font.FontSize << Font.Ascent << Font.Descent << Font.MetricsTotalSurface << Font.FallbackChar << Font.EllipsisChar;
+
+		//Glyphs are plain data, and the key includes their layout
+		int32 NumGlyphs = Font.Glyphs.Num();
+		Ar << NumGlyphs;
+		if (Ar.IsLoading())
+		{
+			if (NumGlyphs < 0 || NumGlyphs >= 0xFFFF)
+			{
+				Ar.SetError();
+				return Ar;
+			}
+			Font.Glyphs.SetNumUninitialized(NumGlyphs);
+		}
+		Ar.Serialize(Font.Glyphs.GetData(), NumGlyphs * sizeof(ImFontGlyph));
+		return Ar;
+	}
+
+	static FArchive& operator<<(FArchive& Ar, FCachedFontAtlas& Atlas)
+	{
+		Ar << Atlas.TexWidth << Atlas.TexHeight << Atlas.TexUvWhitePixel;
+		for (ImVec4& TexUvLine : Atlas.TexUvLines)
+		{
+			Ar << TexUvLine;
+		}
+		Ar << Atlas.CustomRectPositions << Atlas.Fonts << Atlas.Pixels;
+		return Ar;
+	}
+
+	static int32 FindFontIndex(const ImFontAtlas& Atlas, const ImFont* Font)
+	{
+		return Font != nullptr ? Atlas.Fonts.index_from_ptr(Atlas.Fonts.find(const_cast<ImFont*>(Font))) : -1;
+	}
+
+	//Hashes every input of the font builders. Has to run before ImFontAtlasBuildInit adds its own custom rects.
+	static FSHAHash ComputeFontAtlasKey(const ImFontAtlas& Atlas, EImGuiFontRasterizer Rasterizer, uint32 FreeTypeFlags)
+	{
+		FSHA1 Sha;
+		auto HashValue = [&Sha](const auto& Value)
+		{
+			Sha.Update(reinterpret_cast<const uint8*>(&Value), sizeof(Value));
+		};
+		auto HashVec2 = [&HashValue](const ImVec2& Value)
+		{
+			HashValue(Value.x);
+			HashValue(Value.y);
+		};
+
+		HashValue(FontAtlasCacheVersion);
+		HashValue(IMGUI_VERSION_NUM);
+		HashValue(sizeof(ImWchar));
+		HashValue(sizeof(ImFontGlyph));
+		HashValue(Atlas.Flags);
+		HashValue(Atlas.TexDesiredWidth);
+		HashValue(Atlas.TexGlyphPadding);
+		HashValue(Atlas.TexSdfSpread);
+		HashValue(Rasterizer);
+		HashValue(FreeTypeFlags);
+		HashValue(Atlas.Fonts.Size);
+
+		HashValue(Atlas.ConfigData.Size);
+		for (const ImFontConfig& Config : Atlas.ConfigData)
+		{
+			HashValue(Config.FontDataSize);
+			Sha.Update(static_cast<const uint8*>(Config.FontData), Config.FontDataSize);
+			HashValue(Config.FontNo);
+			HashValue(Config.SizePixels);
+			HashValue(Config.OversampleH);
+			HashValue(Config.OversampleV);
+			HashValue(Config.PixelSnapH);
+			HashVec2(Config.GlyphExtraSpacing);
+			HashVec2(Config.GlyphOffset);
+			HashValue(Config.GlyphMinAdvanceX);
+			HashValue(Config.GlyphMaxAdvanceX);
+			HashValue(Config.MergeMode);
+			HashValue(Config.RasterizerFlags);
+			HashValue(Config.RasterizerMultiply);
+			HashValue(Config.EllipsisChar);
+			HashValue(FindFontIndex(Atlas, Config.DstFont));
+
+			const ImWchar* Ranges = Config.GlyphRanges != nullptr ? Config.GlyphRanges : const_cast<ImFontAtlas&>(Atlas).GetGlyphRangesDefault();
+			for (; Ranges[0] && Ranges[1]; Ranges += 2)
+			{
+				HashValue(Ranges[0]);
+				HashValue(Ranges[1]);
+			}
+		}
+
+		HashValue(Atlas.CustomRects.Size);
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			HashValue(Rect.Width);
+			HashValue(Rect.Height);
+			HashValue(Rect.GlyphID);
+			HashValue(Rect.GlyphAdvanceX);
+			HashVec2(Rect.GlyphOffset);
+			HashValue(FindFontIndex(Atlas, Rect.Font));
+		}
+
+		for (const ImFont* Font : Atlas.Fonts)
+		{
+			HashValue(Font->FallbackChar);
+		}
+
+		Sha.Final();
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+		return Hash;
+	}
+
+	static bool LoadFontAtlas(ImFontAtlas& Atlas, const FString& Path)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path, FILEREAD_Silent));
+		if (!Reader.IsValid())
+		{
+			return false;
+		}
+
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		*Reader << Magic << Version;
+		if (Magic != FontAtlasCacheMagic || Version != FontAtlasCacheVersion)
+		{
+			return false;
+		}
+
+		FCachedFontAtlas Cached;
+		*Reader << Cached;
+
+		//The key already matched, these only catch truncated or corrupted files
+		ImFontAtlasBuildInit(&Atlas);
+		if (Reader->IsError()
+			|| Cached.TexWidth <= 0 || Cached.TexHeight <= 0 || Cached.Pixels.Num() != Cached.TexWidth * Cached.TexHeight
+			|| Cached.Fonts.Num() != Atlas.Fonts.Size || Cached.CustomRectPositions.Num() != Atlas.CustomRects.Size)
+		{
+			UE_LOG(LogUnrealImGui, Warning, TEXT("Ignoring invalid font atlas cache %s"), *Path);
+			return false;
+		}
+
+		Atlas.ClearTexData();
+		Atlas.TexWidth = Cached.TexWidth;
+		Atlas.TexHeight = Cached.TexHeight;
+		Atlas.TexUvScale = ImVec2(1.0f / Atlas.TexWidth, 1.0f / Atlas.TexHeight);
+		Atlas.TexUvWhitePixel = Cached.TexUvWhitePixel;
+		FMemory::Memcpy(Atlas.TexUvLines, Cached.TexUvLines, sizeof(Atlas.TexUvLines));
+		Atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(Cached.Pixels.Num()));
+		FMemory::Memcpy(Atlas.TexPixelsAlpha8, Cached.Pixels.GetData(), Cached.Pixels.Num());
+
+		for (int32 RectIndex = 0; RectIndex < Atlas.CustomRects.Size; ++RectIndex)
+		{
+			Atlas.CustomRects[RectIndex].X = static_cast<unsigned short>(Cached.CustomRectPositions[RectIndex].X);
+			Atlas.CustomRects[RectIndex].Y = static_cast<unsigned short>(Cached.CustomRectPositions[RectIndex].Y);
+		}
+
+		//Same state ImFontAtlasBuildSetupFont + AddGlyph + ImFontAtlasBuildFinish leave the fonts in
+		for (int32 FontIndex = 0; FontIndex < Atlas.Fonts.Size; ++FontIndex)
+		{
+			ImFont* Font = Atlas.Fonts[FontIndex];
+			const FCachedFont& CachedFont = Cached.Fonts[FontIndex];
+
+			Font->ClearOutputData();
+			Font->ConfigData = nullptr;
+			Font->ConfigDataCount = 0;
+			for (const ImFontConfig& Config : Atlas.ConfigData)
+			{
+				if (Config.DstFont == Font)
+				{
+					Font->ConfigData = Font->ConfigData != nullptr ? Font->ConfigData : &Config;
+					Font->ConfigDataCount++;
+				}
+			}
+
+			Font->ContainerAtlas = &Atlas;
+			Font->FontSize = CachedFont.FontSize;
+			Font->Ascent = CachedFont.Ascent;
+			Font->Descent = CachedFont.Descent;
+			Font->MetricsTotalSurface = CachedFont.MetricsTotalSurface;
+			Font->FallbackChar = static_cast<ImWchar>(CachedFont.FallbackChar);
+			Font->EllipsisChar = static_cast<ImWchar>(CachedFont.EllipsisChar);
+			Font->Glyphs.resize(CachedFont.Glyphs.Num());
+			FMemory::Memcpy(Font->Glyphs.Data, CachedFont.Glyphs.GetData(), CachedFont.Glyphs.Num() * sizeof(ImFontGlyph));
+			Font->BuildLookupTable();
+		}
+		return true;
+	}
+
+	static void SaveFontAtlas(const ImFontAtlas& Atlas, const FString& Path)
+	{
+		FCachedFontAtlas Cached;
+		Cached.TexWidth = Atlas.TexWidth;
+		Cached.TexHeight = Atlas.TexHeight;
+		Cached.TexUvWhitePixel = Atlas.TexUvWhitePixel;
+		FMemory::Memcpy(Cached.TexUvLines, Atlas.TexUvLines, sizeof(Cached.TexUvLines));
+		Cached.Pixels = TArray<uint8>(Atlas.TexPixelsAlpha8, Atlas.TexWidth * Atlas.TexHeight);
+
+		for (const ImFontAtlasCustomRect& Rect : Atlas.CustomRects)
+		{
+			Cached.CustomRectPositions.Add(FIntPoint(Rect.X, Rect.Y));
+		}
+
+		for (const ImFont* Font : Atlas.Fonts)
+		{
+			FCachedFont& CachedFont = Cached.Fonts.AddDefaulted_GetRef();
+			CachedFont.FontSize = Font->FontSize;
+			CachedFont.Ascent = Font->Ascent;
+			CachedFont.Descent = Font->Descent;
+			CachedFont.MetricsTotalSurface = Font->MetricsTotalSurface;
+			CachedFont.FallbackChar = Font->FallbackChar;
+			CachedFont.EllipsisChar = Font->EllipsisChar;
+			CachedFont.Glyphs = TArray<ImFontGlyph>(Font->Glyphs.Data, Font->Glyphs.Size);
+		}
+
+		//Write next to the final file first, so a crash mid-write never leaves a truncated cache behind
+		const FString TempPath = Path + TEXT(".tmp");
+		{
+			TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+			if (!Writer.IsValid())
+			{
+				UE_LOG(LogUnrealImGui, Warning, TEXT("Unable to write font atlas cache %s"), *TempPath);
+				return;
+			}
+
+			uint32 Magic = FontAtlasCacheMagic;
+			uint32 Version = FontAtlasCacheVersion;
+			*Writer << Magic << Version << Cached;
+			if (!Writer->Close())
+			{
+				IFileManager::Get().Delete(*TempPath);
+				return;
+			}
+		}
+		IFileManager::Get().Move(*Path, *TempPath);
+	}
+
+	//Rasterizer that will actually be used for Settings
+	static EImGuiFontRasterizer ResolveRasterizer(const ImFontAtlas& Atlas, const FImGuiFontBuildSettings& Settings)
+	{
+		if (Settings.Rasterizer == EImGuiFontRasterizer::FreeType && (Atlas.Flags & ImFontAtlasFlags_SignedDistanceField) == 0 && WITH_IMGUI_FREETYPE)
+		{
+			return EImGuiFontRasterizer::FreeType;
+		}
+		return EImGuiFontRasterizer::StbTruetype;
+	}
+
+	bool BuildFontAtlas(ImFontAtlas& Atlas, const FImGuiFontBuildSettings& Settings)
+	{
+		const EImGuiFontRasterizer Rasterizer = ResolveRasterizer(Atlas, Settings);
+		if (Rasterizer != Settings.Rasterizer)
+		{
+			UE_LOG(LogUnrealImGui, Warning, TEXT("FreeType font rasterizer unavailable (%s), using stb_truetype"),
+				(Atlas.Flags & ImFontAtlasFlags_SignedDistanceField) != 0 ? TEXT("signed distance fields need stb_truetype") : TEXT("module built without WITH_IMGUI_FREETYPE"));
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		bool bBuilt = false;
+#if WITH_IMGUI_FREETYPE
+		if (Rasterizer == EImGuiFontRasterizer::FreeType)
+		{
+			bBuilt = ImGuiFreeType::BuildFontAtlas(&Atlas, Settings.FreeTypeFlags);
+		}
+		else
+#endif
+		{
+			bBuilt = Atlas.Build();
+		}
+
+		if (bBuilt)
+		{
+			UE_LOG(LogUnrealImGui, Log, TEXT("Built font atlas (%dx%d, %d fonts) in %.1f ms"), Atlas.TexWidth, Atlas.TexHeight, Atlas.Fonts.Size, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+		return bBuilt;
+	}
+
+	bool BuildFontAtlasCached(ImFontAtlas& Atlas, const FImGuiFontBuildSettings& Settings, const FString& CacheDirectory)
+	{
+		//Same default as ImFontAtlas::GetTexDataAsAlpha8
+		if (Atlas.ConfigData.empty())
+		{
+			Atlas.AddFontDefault();
+		}
+
+		const FSHAHash Key = ComputeFontAtlasKey(Atlas, ResolveRasterizer(Atlas, Settings), Settings.FreeTypeFlags);
+		const FString CachePath = FPaths::Combine(CacheDirectory, FString::Printf(TEXT("FontAtlas-%s.bin"), *Key.ToString()));
+		if (LoadFontAtlas(Atlas, CachePath))
+		{
+			UE_LOG(LogUnrealImGui, Verbose, TEXT("Loaded font atlas from %s"), *CachePath);
+			return true;
+		}
+
+		if (!BuildFontAtlas(Atlas, Settings))
+		{
+			return false;
+		}
+
+		SaveFontAtlas(Atlas, CachePath);
+		return true;
+	}
+}
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealImGui.h"
+
+namespace UnrealImGui
+{
+	enum class EImGuiFontRasterizer : uint8
+	{
+		StbTruetype,
+		FreeType,	//Requires WITH_IMGUI_FREETYPE (see UnrealImGui.Build.cs)
+	};
+
+	struct FImGuiFontBuildSettings
+	{
+		EImGuiFontRasterizer Rasterizer = EImGuiFontRasterizer::StbTruetype;
+		uint32 FreeTypeFlags = 0;	//ImGuiFreeType::RasterizerFlags applied to every font (hinting, bold...)
+	};
+
+	//Game Thread: Builds Atlas (as Alpha8) with the requested rasterizer. Falls back to stb_truetype when FreeType isn't compiled in,
+	//or when the atlas asks for signed distance fields, which only the stb_truetype builder produces.
+	bool BuildFontAtlas(ImFontAtlas& Atlas, const FImGuiFontBuildSettings& Settings);
+
+	//Game Thread: Same as BuildFontAtlas, but loads the result of a previous build from CacheDirectory when there is one.
+	//Cached atlases are keyed by everything that affects the build: font data, sizes, glyph ranges, oversampling, custom rects, rasterizer...
+	//Returns false if the atlas couldn't be built.
+	bool BuildFontAtlasCached(ImFontAtlas& Atlas, const FImGuiFontBuildSettings& Settings, const FString& CacheDirectory);
+}
@@ -0,0 +1,11 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+//ImGui's FreeType font builder, compiled in when UnrealImGui.Build.cs enables it
+
+#include "UnrealImGui.h"
+
+#if WITH_IMGUI_FREETYPE
+THIRD_PARTY_INCLUDES_START
+#include "ThirdParty/ImGui/misc/freetype/imgui_freetype.cpp"
+THIRD_PARTY_INCLUDES_END
+#endif
@@ -106,6 +106,14 @@ bool UImGuiFunctionLibrary::ImguiButton(const FString& Label)
 	return IMGUI_CALL_WITH_RESULT(ImGui::Button(TCHAR_TO_ANSI(*Label)));
 }
 
+void UImGuiFunctionLibrary::ImguiImage(UTexture* Texture, FVector2D Size, bool bIgnoreAlpha)
+{
+	if (Texture != nullptr)
+	{
+		IMGUI_CALL(ImGui::Image(UnrealImGui::RegisterTexture(Texture, bIgnoreAlpha), ImVec2(Size.X, Size.Y)));
+	}
+}
+
 bool UImGuiFunctionLibrary::ImguiCheckbox(const FString& Label, UPARAM(ref) bool& BoolRef)
 {
 	return IMGUI_CALL_WITH_RESULT(ImGui::Checkbox(TCHAR_TO_ANSI(*Label), &BoolRef));
@@ -0,0 +1,386 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiGlyphCache.h"
+#include "ImGuiStats.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+void UnrealImGui::FImGuiGlyphCache::Initialize(ImFontAtlas& InAtlas, int32 NumPages, int32 InPageSize)
+{
+	check(InAtlas.TexPixelsAlpha8 != nullptr);
+	check(Atlas == nullptr);
+
+	Atlas = &InAtlas;
+	const int32 Width = Atlas->TexWidth;
+	PageSize = FMath::Min(InPageSize, Width);
+
+	const int32 PagesPerRow = Width / PageSize;
+	const int32 RegionHeight = FMath::DivideAndRoundUp(FMath::Max(NumPages, 1), PagesPerRow) * PageSize;
+	RegionY = Atlas->TexHeight;
+	const int32 NewHeight = RegionY + RegionHeight;
+
+	//Grow the atlas, leaving the new rows empty
+	unsigned char* NewPixels = static_cast<unsigned char*>(IM_ALLOC(Width * NewHeight));
+	FMemory::Memcpy(NewPixels, Atlas->TexPixelsAlpha8, Width * RegionY);
+	FMemory::Memzero(NewPixels + Width * RegionY, Width * RegionHeight);
+	IM_FREE(Atlas->TexPixelsAlpha8);
+	Atlas->TexPixelsAlpha8 = NewPixels;
+
+	//Rebuilt from the Alpha8 pixels by GetTexDataAsRGBA32
+	if (Atlas->TexPixelsRGBA32 != nullptr)
+	{
+		IM_FREE(Atlas->TexPixelsRGBA32);
+		Atlas->TexPixelsRGBA32 = nullptr;
+	}
+
+	//Everything baked so far has UVs normalized to the old height
+	const float VScale = static_cast<float>(RegionY) / NewHeight;
+	for (ImFont* Font : Atlas->Fonts)
+	{
+		for (ImFontGlyph& Glyph : Font->Glyphs)
+		{
+			Glyph.V0 *= VScale;
+			Glyph.V1 *= VScale;
+		}
+	}
+	Atlas->TexUvWhitePixel.y *= VScale;
+	for (ImVec4& TexUvLine : Atlas->TexUvLines)
+	{
+		TexUvLine.y *= VScale;
+		TexUvLine.w *= VScale;
+	}
+	Atlas->TexHeight = NewHeight;
+	Atlas->TexUvScale = ImVec2(1.0f / Width, 1.0f / NewHeight);
+
+	Pixels.SetNumZeroed(Width * RegionHeight);
+	Pages.SetNum(NumPages);
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); ++PageIndex)
+	{
+		FPage& Page = Pages[PageIndex];
+		Page.X = (PageIndex % PagesPerRow) * PageSize;
+		Page.Y = (PageIndex / PagesPerRow) * PageSize;
+		stbtt_PackBegin(&Page.PackContext, Pixels.GetData() + Page.Y * Width + Page.X, PageSize, PageSize, Width, Atlas->TexGlyphPadding, nullptr);
+	}
+
+	for (ImFont* Font : Atlas->Fonts)
+	{
+		FFont& CachedFont = Fonts.AddDefaulted_GetRef();
+		CachedFont.Font = Font;
+		CachedFont.NumBakedGlyphs = Font->Glyphs.Size;
+
+		for (const ImFontConfig& Config : Atlas->ConfigData)
+		{
+			if (Config.DstFont != Font)
+			{
+				continue;
+			}
+
+			FSource Source;
+			Source.Config = &Config;
+			const unsigned char* FontData = static_cast<const unsigned char*>(Config.FontData);
+			if (stbtt_InitFont(&Source.FontInfo, FontData, stbtt_GetFontOffsetForIndex(FontData, Config.FontNo)))
+			{
+				CachedFont.Sources.Add(Source);
+			}
+		}
+
+		//Codepoints without a baked glyph haven't been requested yet, rather than being known to be missing
+		for (int32 Codepoint = 0; Codepoint < Font->IndexLookup.Size; ++Codepoint)
+		{
+			if (Font->IndexLookup[Codepoint] == (ImWchar)-1)
+			{
+				Font->IndexAdvanceX[Codepoint] = -1.0f;
+			}
+		}
+		Font->ClearTextSizeCache();
+
+		Font->GlyphsLastUsed.resize(Font->Glyphs.Size, 0);
+		Font->GlyphsUseStamp = FrameStamp;
+	}
+
+	Atlas->GlyphLoader = &FImGuiGlyphCache::LoadGlyphCallback;
+	Atlas->GlyphLoaderUserData = this;
+}
+
+void UnrealImGui::FImGuiGlyphCache::Shutdown()
+{
+	if (Atlas == nullptr)
+	{
+		return;
+	}
+
+	Atlas->GlyphLoader = nullptr;
+	Atlas->GlyphLoaderUserData = nullptr;
+	for (FFont& CachedFont : Fonts)
+	{
+		CachedFont.Font->GlyphsLastUsed.clear();
+	}
+
+	for (FPage& Page : Pages)
+	{
+		stbtt_PackEnd(&Page.PackContext);
+	}
+
+	Atlas = nullptr;
+	Fonts.Reset();
+	Pages.Reset();
+	Pixels.Empty();
+	bOutOfSpaceThisFrame = false;
+}
+
+void UnrealImGui::FImGuiGlyphCache::NewFrame()
+{
+	++FrameStamp;
+	for (FFont& CachedFont : Fonts)
+	{
+		CachedFont.Font->GlyphsUseStamp = FrameStamp;
+	}
+	bOutOfSpaceThisFrame = false;
+}
+
+void UnrealImGui::FImGuiGlyphCache::GatherUploads(TArray<FUpload>& OutUploads)
+{
+	if (Atlas == nullptr)
+	{
+		return;
+	}
+
+	const int32 Width = Atlas->TexWidth;
+	for (FPage& Page : Pages)
+	{
+		if (Page.DirtyRect.Area() == 0)
+		{
+			continue;
+		}
+
+		FUpload& Upload = OutUploads.AddDefaulted_GetRef();
+		Upload.X = Page.DirtyRect.Min.X;
+		Upload.Y = RegionY + Page.DirtyRect.Min.Y;
+		Upload.Width = Page.DirtyRect.Width();
+		Upload.Height = Page.DirtyRect.Height();
+		Upload.Pixels.SetNumUninitialized(Upload.Width * Upload.Height);
+		for (int32 Row = 0; Row < Upload.Height; ++Row)
+		{
+			const uint8* Src = Pixels.GetData() + (Page.DirtyRect.Min.Y + Row) * Width + Page.DirtyRect.Min.X;
+			FMemory::Memcpy(Upload.Pixels.GetData() + Row * Upload.Width, Src, Upload.Width);
+		}
+
+		Page.DirtyRect = FIntRect();
+	}
+}
+
+bool UnrealImGui::FImGuiGlyphCache::LoadGlyphCallback(ImFont* Font, ImWchar Codepoint)
+{
+	FImGuiGlyphCache* GlyphCache = static_cast<FImGuiGlyphCache*>(Font->ContainerAtlas->GlyphLoaderUserData);
+	const int32 FontIndex = GlyphCache->Fonts.IndexOfByPredicate([Font](const FFont& CachedFont) { return CachedFont.Font == Font; });
+	return FontIndex != INDEX_NONE && GlyphCache->LoadGlyph(FontIndex, Codepoint);
+}
+
+bool UnrealImGui::FImGuiGlyphCache::LoadGlyph(int32 FontIndex, ImWchar Codepoint)
+{
+	FFont& CachedFont = Fonts[FontIndex];
+	ImFont* Font = CachedFont.Font;
+
+	//Already requested, and known to be unavailable
+	if (Codepoint < Font->IndexAdvanceX.Size && Font->IndexAdvanceX[Codepoint] >= 0.0f)
+	{
+		return false;
+	}
+
+	//Every page is in use this frame, try again next frame
+	if (bOutOfSpaceThisFrame)
+	{
+		return false;
+	}
+
+	auto UseFallbackGlyph = [&CachedFont, Font, Codepoint]()
+	{
+		//Unless the fallback glyph can be evicted itself, point straight at it so we don't ask again
+		Font->GrowIndex(Codepoint + 1);
+		const int32 FallbackIndex = Font->FallbackGlyph != nullptr ? static_cast<int32>(Font->FallbackGlyph - Font->Glyphs.Data) : INDEX_NONE;
+		if (FallbackIndex != INDEX_NONE && FallbackIndex < CachedFont.NumBakedGlyphs)
+		{
+			Font->IndexLookup[Codepoint] = static_cast<ImWchar>(FallbackIndex);
+		}
+		Font->IndexAdvanceX[Codepoint] = Font->FallbackAdvanceX;
+		return false;
+	};
+
+	//Merged fonts take priority in the order they were added
+	const FSource* Source = CachedFont.Sources.FindByPredicate([Codepoint](const FSource& Candidate)
+	{
+		return stbtt_FindGlyphIndex(&Candidate.FontInfo, Codepoint) != 0;
+	});
+	if (Source == nullptr)
+	{
+		return UseFallbackGlyph();
+	}
+
+	//ImWchar lookups reserve 0xFFFF
+	if (CachedFont.FreeGlyphs.Num() == 0 && Font->Glyphs.Size >= 0xFFFE)
+	{
+		return UseFallbackGlyph();
+	}
+
+	stbtt_packedchar PackedChar;
+	FPage* Page = Pages.FindByPredicate([this, Source, Codepoint, &PackedChar](FPage& Candidate)
+	{
+		return !Candidate.bFull && PackGlyph(Candidate, *Source, Codepoint, PackedChar);
+	});
+	if (Page == nullptr)
+	{
+		Page = FindPageToEvict();
+		if (Page == nullptr)
+		{
+			bOutOfSpaceThisFrame = true;
+			return false;
+		}
+
+		EvictPage(*Page);
+		if (!PackGlyph(*Page, *Source, Codepoint, PackedChar))
+		{
+			//Doesn't fit in an empty page either
+			return UseFallbackGlyph();
+		}
+	}
+
+	//PackedChar is relative to the page, move it into the atlas
+	PackedChar.x0 += Page->X;
+	PackedChar.x1 += Page->X;
+	PackedChar.y0 += RegionY + Page->Y;
+	PackedChar.y1 += RegionY + Page->Y;
+
+	stbtt_aligned_quad Quad;
+	float UnusedX = 0.0f, UnusedY = 0.0f;
+	stbtt_GetPackedQuad(&PackedChar, Atlas->TexWidth, Atlas->TexHeight, 0, &UnusedX, &UnusedY, &Quad, 0);
+
+	//Same placement as ImFontAtlasBuildWithStbTruetype
+	const ImFontConfig& Config = *Source->Config;
+	const float OffsetX = Config.GlyphOffset.x;
+	const float OffsetY = Config.GlyphOffset.y + IM_ROUND(Font->Ascent);
+
+	const ImFontGlyph* PreviousGlyphs = Font->Glyphs.Data;
+	Font->AddGlyph(&Config, Codepoint, Quad.x0 + OffsetX, Quad.y0 + OffsetY, Quad.x1 + OffsetX, Quad.y1 + OffsetY, Quad.s0, Quad.t0, Quad.s1, Quad.t1, PackedChar.xadvance);
+	Font->DirtyLookupTables = false; //We keep the lookup tables up to date ourselves
+
+	int32 GlyphIndex = Font->Glyphs.Size - 1;
+	if (CachedFont.FreeGlyphs.Num() > 0)
+	{
+		GlyphIndex = CachedFont.FreeGlyphs.Pop(false);
+		Font->Glyphs[GlyphIndex] = Font->Glyphs.back();
+		Font->Glyphs.pop_back();
+	}
+	if (Font->Glyphs.Data != PreviousGlyphs)
+	{
+		Font->FallbackGlyph = Font->FindGlyphNoFallback(Font->FallbackChar);
+	}
+
+	Font->GlyphsLastUsed.resize(Font->Glyphs.Size, 0);
+	Font->GlyphsLastUsed[GlyphIndex] = FrameStamp;
+	Font->GrowIndex(Codepoint + 1);
+	Font->IndexLookup[Codepoint] = static_cast<ImWchar>(GlyphIndex);
+	Font->IndexAdvanceX[Codepoint] = Font->Glyphs[GlyphIndex].AdvanceX;
+	const int32 Used4kPage = Codepoint / 4096;
+	Font->Used4kPagesMap[Used4kPage >> 3] |= 1 << (Used4kPage & 7);
+
+	Page->Glyphs.Add({ FontIndex, GlyphIndex });
+	INC_DWORD_STAT(STAT_ImGuiGlyphsRasterized);
+	return true;
+}
+
+bool UnrealImGui::FImGuiGlyphCache::PackGlyph(FPage& Page, const FSource& Source, ImWchar Codepoint, stbtt_packedchar& OutPackedChar)
+{
+	const ImFontConfig& Config = *Source.Config;
+	stbtt_PackSetOversampling(&Page.PackContext, Config.OversampleH, Config.OversampleV);
+
+	int PackedCodepoint = Codepoint;
+	stbtt_pack_range Range = {};
+	Range.font_size = Config.SizePixels;
+	Range.array_of_unicode_codepoints = &PackedCodepoint;
+	Range.num_chars = 1;
+	Range.chardata_for_range = &OutPackedChar;
+
+	stbrp_rect Rect = {};
+	stbtt_PackFontRangesGatherRects(&Page.PackContext, &Source.FontInfo, &Range, 1, &Rect);
+	stbrp_pack_rects(static_cast<stbrp_context*>(Page.PackContext.pack_info), &Rect, 1);
+	if (!Rect.was_packed)
+	{
+		Page.bFull = true;
+		return false;
+	}
+
+	stbtt_PackFontRangesRenderIntoRects(&Page.PackContext, &Source.FontInfo, &Range, 1, &Rect);
+	if (Config.RasterizerMultiply != 1.0f)
+	{
+		unsigned char MultiplyTable[256];
+		ImFontAtlasBuildMultiplyCalcLookupTable(MultiplyTable, Config.RasterizerMultiply);
+		ImFontAtlasBuildMultiplyRectAlpha8(MultiplyTable, Page.PackContext.pixels, Rect.x, Rect.y, Rect.w, Rect.h, Page.PackContext.stride_in_bytes);
+	}
+
+	MarkDirty(Page, FIntRect(Page.X + Rect.x, Page.Y + Rect.y, Page.X + Rect.x + Rect.w, Page.Y + Rect.y + Rect.h));
+	return true;
+}
+
+UnrealImGui::FImGuiGlyphCache::FPage* UnrealImGui::FImGuiGlyphCache::FindPageToEvict()
+{
+	FPage* OldestPage = nullptr;
+	int32 OldestStamp = MAX_int32;
+	for (FPage& Page : Pages)
+	{
+		int32 LastUsed = 0;
+		for (const FGlyphRef& GlyphRef : Page.Glyphs)
+		{
+			LastUsed = FMath::Max(LastUsed, Fonts[GlyphRef.FontIndex].Font->GlyphsLastUsed[GlyphRef.GlyphIndex]);
+		}
+
+		//Glyphs used this frame may already be in ImGui's draw lists
+		if (LastUsed < FrameStamp && LastUsed < OldestStamp)
+		{
+			OldestPage = &Page;
+			OldestStamp = LastUsed;
+		}
+	}
+	return OldestPage;
+}
+
+void UnrealImGui::FImGuiGlyphCache::EvictPage(FPage& Page)
+{
+	for (const FGlyphRef& GlyphRef : Page.Glyphs)
+	{
+		FFont& CachedFont = Fonts[GlyphRef.FontIndex];
+		ImFontGlyph& Glyph = CachedFont.Font->Glyphs[GlyphRef.GlyphIndex];
+
+		//Back to not requested, so it's loaded again the next time it's used
+		CachedFont.Font->IndexLookup[Glyph.Codepoint] = (ImWchar)-1;
+		CachedFont.Font->IndexAdvanceX[Glyph.Codepoint] = -1.0f;
+		Glyph.Visible = 0;
+		CachedFont.FreeGlyphs.Add(GlyphRef.GlyphIndex);
+		//Text quads cached by ImGui::RenderText may point at this glyph
+		CachedFont.Font->MarkGlyphsChanged();
+	}
+	Page.Glyphs.Reset();
+	Page.bFull = false;
+
+	//Clear the old glyphs so they can't bleed into new ones through bilinear filtering
+	const int32 Width = Atlas->TexWidth;
+	for (int32 Row = 0; Row < PageSize; ++Row)
+	{
+		FMemory::Memzero(Pixels.GetData() + (Page.Y + Row) * Width + Page.X, PageSize);
+	}
+	stbtt_PackEnd(&Page.PackContext);
+	stbtt_PackBegin(&Page.PackContext, Pixels.GetData() + Page.Y * Width + Page.X, PageSize, PageSize, Width, Atlas->TexGlyphPadding, nullptr);
+
+	MarkDirty(Page, FIntRect(Page.X, Page.Y, Page.X + PageSize, Page.Y + PageSize));
+	INC_DWORD_STAT(STAT_ImGuiGlyphPagesEvicted);
+}
+
+void UnrealImGui::FImGuiGlyphCache::MarkDirty(FPage& Page, const FIntRect& Rect)
+{
+	if (Page.DirtyRect.Area() == 0)
+	{
+		Page.DirtyRect = Rect;
+	}
+	else
+	{
+		Page.DirtyRect.Union(Rect);
+	}
+}
@@ -0,0 +1,93 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealImGui.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "ThirdParty/ImGui/imstb_rectpack.h"
+#include "ThirdParty/ImGui/imstb_truetype.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UnrealImGui
+{
+	//Game Thread: Rasterizes glyphs the font atlas was built without the first time ImGui asks for them.
+	//Reserves a region of fixed size pages below the baked glyphs. Each page is packed with stb_rect_pack, and the page whose glyphs
+	//were used least recently is cleared when none has room left. Only the parts of the atlas touched since the last frame are uploaded.
+	class FImGuiGlyphCache
+	{
+	public:
+		//Region of the atlas to upload, as tightly packed Alpha8 pixels
+		struct FUpload
+		{
+			int32 X;
+			int32 Y;
+			int32 Width;
+			int32 Height;
+			TArray<uint8> Pixels;
+		};
+
+		//Grows Atlas to make room for NumPages pages of PageSize x PageSize and installs itself as the atlas' GlyphLoader.
+		//Has to be called once the atlas is built (GetTexDataAsAlpha8), before its pixels are uploaded.
+		//The atlas' input data (ImFontConfig::FontData) has to stay around, glyphs are rasterized from it.
+		void Initialize(ImFontAtlas& InAtlas, int32 NumPages, int32 InPageSize);
+
+		//Has to be called while the atlas still exists (before ImGui::DestroyContext)
+		void Shutdown();
+		bool IsInitialized() const { return Atlas != nullptr; }
+
+		//Call before ImGui::NewFrame(). Glyphs used from then on can't be evicted until the next frame.
+		void NewFrame();
+
+		//Moves the atlas regions modified since the last call into OutUploads
+		void GatherUploads(TArray<FUpload>& OutUploads);
+
+	private:
+		struct FSource
+		{
+			const ImFontConfig* Config;
+			stbtt_fontinfo FontInfo;
+		};
+
+		struct FFont
+		{
+			ImFont* Font;
+			TArray<FSource> Sources;    // Source fonts merged into Font, in priority order
+			int32 NumBakedGlyphs;       // Glyphs before this index were built with the atlas and never move
+			TArray<int32> FreeGlyphs;   // Glyph slots freed by evictions, reused before growing Font->Glyphs
+		};
+
+		struct FGlyphRef
+		{
+			int32 FontIndex;
+			int32 GlyphIndex;
+		};
+
+		struct FPage
+		{
+			int32 X;                    // Origin in the dynamic region
+			int32 Y;
+			stbtt_pack_context PackContext;
+			TArray<FGlyphRef> Glyphs;
+			bool bFull = false;         // A glyph didn't fit, stop trying until the page is evicted
+			FIntRect DirtyRect;         // In dynamic region coordinates, zero area if nothing changed
+		};
+
+		static bool LoadGlyphCallback(ImFont* Font, ImWchar Codepoint);
+		bool LoadGlyph(int32 FontIndex, ImWchar Codepoint);
+		bool PackGlyph(FPage& Page, const FSource& Source, ImWchar Codepoint, stbtt_packedchar& OutPackedChar);
+		FPage* FindPageToEvict();
+		void EvictPage(FPage& Page);
+		void MarkDirty(FPage& Page, const FIntRect& Rect);
+
+		ImFontAtlas* Atlas = nullptr;
+		TArray<FFont> Fonts;
+		TArray<FPage> Pages;
+		TArray<uint8> Pixels;           // CPU copy of the dynamic region, Alpha8
+		int32 RegionY = 0;              // Top of the dynamic region in the atlas
+		int32 PageSize = 0;
+		int32 FrameStamp = 0;
+		bool bOutOfSpaceThisFrame = false;
+	};
+}
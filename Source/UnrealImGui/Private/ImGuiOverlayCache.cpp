@@ -0,0 +1,88 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiOverlayCache.h"
+#include "ImGuiPrimitives.h"
+#include "PixelShaderUtils.h"
+#include "RenderGraphBuilder.h"
+
+IMPLEMENT_SHADER_TYPE(, FImGuiOverlayCompositePS, TEXT("/Plugin/UnrealImGui/Private/ImGuiOverlay.usf"), TEXT("CompositePS"), SF_Pixel);
+
+namespace UnrealImGui
+{
+	static bool GOverlayCache = false;
+	static FAutoConsoleVariableRef CVarOverlayCache = FAutoConsoleVariableRef(
+		TEXT("imgui.overlaycache"),
+		GOverlayCache,
+		TEXT("If enabled, a frame that stays unchanged is drawn once into an overlay texture, and later frames just blend that texture over the viewport\n")
+		TEXT("Only applies to frames that draw nothing but text and shapes (no images or draw callbacks), and requires imgui.reuseframes. Costs a viewport sized RGBA8 texture"),
+		ECVF_RenderThreadSafe
+	);
+}
+
+bool UnrealImGui::UseOverlayCache()
+{
+	return GOverlayCache;
+}
+
+bool UnrealImGui::FImGuiOverlayCache::CanCache(const FUnrealImGuiDrawData& DrawData)
+{
+	//Texture 0 is always the font atlas
+	if (DrawData.Textures.Num() != 1)
+	{
+		return false;
+	}
+	return !DrawData.CmdBuffer.ContainsByPredicate([](const FUnrealImGuiDrawCmd& Cmd)
+	{
+		return Cmd.UserCallback != nullptr && Cmd.UserCallback != PrimitiveBatchCallback && Cmd.UserCallback != ImDrawCallback_ResetRenderState;
+	});
+}
+
+FRDGTextureRef UnrealImGui::FImGuiOverlayCache::Register(FRDGBuilder& GraphBuilder, const FRDGTextureDesc& TargetDesc, uint64 ContentHash, bool& bOutUpToDate)
+{
+	check(IsInRenderingThread());
+
+	//Keep the target's sRGB conversion, so blending happens in the same space whether we draw directly or through the overlay
+	const ETextureCreateFlags Flags = TexCreate_RenderTargetable | TexCreate_ShaderResource | (TargetDesc.Flags & TexCreate_SRGB);
+	const bool bTextureMatches = PooledTexture.IsValid() && PooledTexture->GetDesc().Extent == TargetDesc.Extent && PooledTexture->GetDesc().Flags == Flags;
+
+	bOutUpToDate = bTextureMatches && ContentHash == CachedContentHash;
+	const bool bStable = ContentHash == LastContentHash;
+	LastContentHash = ContentHash;
+	if (!bOutUpToDate && !bStable)
+	{
+		return nullptr;
+	}
+
+	CachedContentHash = ContentHash;
+	if (bTextureMatches)
+	{
+		return GraphBuilder.RegisterExternalTexture(PooledTexture);
+	}
+
+	const FRDGTextureDesc OverlayDesc = FRDGTextureDesc::Create2D(TargetDesc.Extent, PF_B8G8R8A8, FClearValueBinding::Transparent, Flags);
+	FRDGTextureRef Overlay = GraphBuilder.CreateTexture(OverlayDesc, TEXT("ImGuiOverlay"));
+	PooledTexture = GraphBuilder.ConvertToExternalTexture(Overlay);
+	return Overlay;
+}
+
+void UnrealImGui::FImGuiOverlayCache::AddCompositePass(FRDGBuilder& GraphBuilder, ERHIFeatureLevel::Type FeatureLevel, FRDGTextureRef Overlay, FRDGTextureRef RenderTarget)
+{
+	FImGuiOverlayCompositePS::FParameters* PassParameters = GraphBuilder.AllocParameters<FImGuiOverlayCompositePS::FParameters>();
+	PassParameters->OverlayTexture = Overlay;
+	PassParameters->RenderTargets[0] = FRenderTargetBinding(RenderTarget, ERenderTargetLoadAction::ELoad);
+
+	//Premultiplied, and the target's alpha is left alone
+	FRHIBlendState* BlendState = TStaticBlendState<CW_RGB, BO_Add, BF_One, BF_InverseSourceAlpha>::GetRHI();
+
+	const FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(FeatureLevel);
+	TShaderMapRef<FImGuiOverlayCompositePS> PixelShader(ShaderMap);
+	FPixelShaderUtils::AddFullscreenPass(GraphBuilder, ShaderMap, RDG_EVENT_NAME("ImGuiOverlayComposite"), PixelShader, PassParameters,
+		FIntRect(FIntPoint::ZeroValue, Overlay->Desc.Extent), BlendState);
+}
+
+void UnrealImGui::FImGuiOverlayCache::Reset()
+{
+	PooledTexture.SafeRelease();
+	CachedContentHash = 0;
+	LastContentHash = 0;
+}
@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealImGui.h"
+#include "RenderGraphResources.h"
+
+namespace UnrealImGui
+{
+	//Returns true if frames that stop changing should be drawn once into an overlay texture and composited from it afterwards
+	bool UseOverlayCache();
+
+	//Render Thread: Keeps ImGui's output in a texture between frames, so an unchanged frame costs a single fullscreen blend instead of every draw.
+	//The overlay holds premultiplied color and coverage (EImGuiBlendMode::Overlay), which composites to the same result as drawing straight onto the target, up to 8-bit rounding.
+	class FImGuiOverlayCache
+	{
+	public:
+		//Whether DrawData can be drawn through the overlay. It may only sample the font atlas, as other textures can change without ImGui's output changing,
+		//and can't have user callbacks, which draw straight to the target.
+		static bool CanCache(const FUnrealImGuiDrawData& DrawData);
+
+		//Returns the overlay to use for a frame with ContentHash drawn over a target described by TargetDesc, or nullptr if the frame should be drawn directly.
+		//bOutUpToDate is set when the overlay already holds the frame and only needs compositing. Otherwise the caller clears it and draws the frame into it.
+		//Frames are only drawn into the overlay once they've been seen twice in a row, so UIs that change every frame don't pay for the extra blend.
+		FRDGTextureRef Register(FRDGBuilder& GraphBuilder, const FRDGTextureDesc& TargetDesc, uint64 ContentHash, bool& bOutUpToDate);
+
+		//Blends Overlay over RenderTarget
+		static void AddCompositePass(FRDGBuilder& GraphBuilder, ERHIFeatureLevel::Type FeatureLevel, FRDGTextureRef Overlay, FRDGTextureRef RenderTarget);
+
+		//Makes the next frame redraw the overlay, e.g. after glyphs were written into the font atlas
+		void Invalidate() { CachedContentHash = 0; }
+
+		//Releases the overlay texture
+		void Reset();
+
+	private:
+		TRefCountPtr<IPooledRenderTarget> PooledTexture;
+		uint64 CachedContentHash = 0;	//Frame the overlay holds
+		uint64 LastContentHash = 0;		//Last frame we were asked about
+	};
+}
+
+//Blends the premultiplied overlay over the target
+class FImGuiOverlayCompositePS : public FGlobalShader
+{
+	DECLARE_SHADER_TYPE(FImGuiOverlayCompositePS, Global);
+	SHADER_USE_PARAMETER_STRUCT(FImGuiOverlayCompositePS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D, OverlayTexture)
+		RENDER_TARGET_BINDING_SLOTS()
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return true;
+	}
+};
@@ -0,0 +1,228 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiPipelineCache.h"
+#include "UnrealImGui.h"
+#include "ImGuiPrimitives.h"
+#include "PipelineStateCache.h"
+
+TGlobalResource<UnrealImGui::FImGuiVertexDeclaration> UnrealImGui::GImGuiVertexDeclaration;
+
+namespace UnrealImGui
+{
+	//Read from any thread recording ImGui draws. Entries are heap allocated so references stay valid while the map grows.
+	static TMap<FImGuiPipelineKey, TUniquePtr<FGraphicsPipelineStateInitializer>> CachedPipelineStates;
+	static FRWLock CachedPipelineStatesLock;
+
+	static FRHIBlendState* GetBlendState(EImGuiBlendMode BlendMode)
+	{
+		switch (BlendMode)
+		{
+		case EImGuiBlendMode::Opaque:
+			return TStaticBlendState<CW_RGBA>::GetRHI();
+		case EImGuiBlendMode::Overlay:
+			return TStaticBlendState<
+				/*EColorWriteMask RT0ColorWriteMask = */ CW_RGBA,
+				/*EBlendOperation RT0ColorBlendOp = */ BO_Add,
+				/*EBlendFactor    RT0ColorSrcBlend = */ BF_SourceAlpha,
+				/*EBlendFactor    RT0ColorDestBlend = */ BF_InverseSourceAlpha,
+				/*EBlendOperation RT0AlphaBlendOp = */ BO_Add,
+				/*EBlendFactor    RT0AlphaSrcBlend = */ BF_One,
+				/*EBlendFactor    RT0AlphaDestBlend = */ BF_InverseSourceAlpha
+			>::GetRHI();
+		case EImGuiBlendMode::AlphaBlend:
+		default:
+			return TStaticBlendState<
+				/*EColorWriteMask RT0ColorWriteMask = */ CW_RGBA,
+				/*EBlendOperation RT0ColorBlendOp = */ BO_Add,
+				/*EBlendFactor    RT0ColorSrcBlend = */ BF_SourceAlpha,
+				/*EBlendFactor    RT0ColorDestBlend = */ BF_InverseSourceAlpha,
+				/*EBlendOperation RT0AlphaBlendOp = */ BO_Add,
+				/*EBlendFactor    RT0AlphaSrcBlend = */ BF_InverseSourceAlpha,
+				/*EBlendFactor    RT0AlphaDestBlend = */ BF_Zero
+			>::GetRHI();
+		}
+	}
+}
+
+UnrealImGui::FImGuiPipelineKey::FImGuiPipelineKey(ERHIFeatureLevel::Type InFeatureLevel, const FRHITexture* RenderTarget, EImGuiBlendMode InBlendMode, EImGuiTextureKind InTextureKind, bool bInMultiTexture, bool bInPrimitives, bool bInShaderClip, bool bInPackedVertices, bool bInAnalyticAA)
+	: FeatureLevel(InFeatureLevel)
+	, RenderTargetFormat(RenderTarget->GetFormat())
+	, RenderTargetFlags(RenderTarget->GetFlags())
+	, NumSamples(RenderTarget->GetNumSamples())
+	, BlendMode(InBlendMode)
+	, TextureKind(InTextureKind)
+	, bMultiTexture(bInMultiTexture)
+	, bPrimitives(bInPrimitives)
+	, bShaderClip(bInShaderClip)
+	, bPackedVertices(bInPackedVertices)
+	, bAnalyticAA(bInAnalyticAA)
+{
+}
+
+void UnrealImGui::FImGuiVertexDeclaration::InitRHI()
+{
+	FVertexDeclarationElementList Elements;
+	const uint32 Stride = sizeof(ImDrawVert);
+	Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, pos), VET_Float2, 0, Stride));
+	Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, uv), VET_Float2, 1, Stride));
+	Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, col), VET_UByte4N, 2, Stride));
+	VertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(Elements);
+
+	//Texture slot and the two bytes of the clip rect index
+	const FVertexElement AuxElement(1, STRUCT_OFFSET(FUnrealImGuiVertexAux, TextureSlot), VET_UByte4, 3, sizeof(FUnrealImGuiVertexAux));
+	Elements.Add(AuxElement);
+	MultiTextureVertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(Elements);
+
+	FVertexDeclarationElementList PackedElements;
+	const uint32 PackedStride = sizeof(FUnrealImGuiPackedVertex);
+	PackedElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPackedVertex, Pos), VET_Short2, 0, PackedStride));
+	PackedElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPackedVertex, UV), VET_Short2N, 1, PackedStride));
+	PackedElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPackedVertex, Col), VET_UByte4N, 2, PackedStride));
+	PackedVertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(PackedElements);
+
+	PackedElements.Add(AuxElement);
+	PackedMultiTextureVertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(PackedElements);
+
+	FVertexDeclarationElementList PrimitiveElements;
+	const uint32 PrimitiveStride = sizeof(FUnrealImGuiPrimitive);
+	PrimitiveElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPrimitive, P0), VET_Float4, 0, PrimitiveStride, true));
+	PrimitiveElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPrimitive, Radius), VET_Float2, 1, PrimitiveStride, true));
+	PrimitiveElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPrimitive, Col), VET_UByte4N, 2, PrimitiveStride, true));
+	PrimitiveElements.Add(FVertexElement(0, STRUCT_OFFSET(FUnrealImGuiPrimitive, Type), VET_UInt, 3, PrimitiveStride, true));
+	PrimitiveVertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(PrimitiveElements);
+}
+
+void UnrealImGui::FImGuiVertexDeclaration::ReleaseRHI()
+{
+	VertexDeclarationRHI.SafeRelease();
+	MultiTextureVertexDeclarationRHI.SafeRelease();
+	PackedVertexDeclarationRHI.SafeRelease();
+	PackedMultiTextureVertexDeclarationRHI.SafeRelease();
+	PrimitiveVertexDeclarationRHI.SafeRelease();
+}
+
+const FGraphicsPipelineStateInitializer& UnrealImGui::GetPipelineState(const FImGuiPipelineKey& Key)
+{
+	check(IsInParallelRenderingThread());
+
+	{
+		FReadScopeLock ReadLock(CachedPipelineStatesLock);
+		if (const TUniquePtr<FGraphicsPipelineStateInitializer>* CachedInitializer = CachedPipelineStates.Find(Key))
+		{
+			return **CachedInitializer;
+		}
+	}
+
+	FImGuiVS::FPermutationDomain VertexPermutationVector;
+	VertexPermutationVector.Set<FImGuiMultiTextureDim>(Key.bMultiTexture);
+	VertexPermutationVector.Set<FImGuiShaderClipDim>(Key.bShaderClip);
+	VertexPermutationVector.Set<FImGuiPackedVertexDim>(Key.bPackedVertices);
+	FImGuiPS::FPermutationDomain PixelPermutationVector;
+	PixelPermutationVector.Set<FImGuiMultiTextureDim>(Key.bMultiTexture);
+	PixelPermutationVector.Set<FImGuiShaderClipDim>(Key.bShaderClip);
+	PixelPermutationVector.Set<FImGuiAlpha8FontDim>(IsAlpha8Font(Key.TextureKind));
+	PixelPermutationVector.Set<FImGuiSdfFontDim>(IsSdfFont(Key.TextureKind));
+	PixelPermutationVector.Set<FImGuiAnalyticAADim>(Key.bAnalyticAA);
+
+	const auto ShaderMap = GetGlobalShaderMap(Key.FeatureLevel);
+
+	FGraphicsPipelineStateInitializer PSOInitializer;
+	PSOInitializer.RenderTargetsEnabled = 1;
+	PSOInitializer.NumSamples = Key.NumSamples;
+	PSOInitializer.RenderTargetFormats[0] = Key.RenderTargetFormat;
+	PSOInitializer.RenderTargetFlags[0] = Key.RenderTargetFlags;
+	PSOInitializer.PrimitiveType = PT_TriangleList;
+	if (Key.bPrimitives)
+	{
+		TShaderMapRef<FImGuiPrimitiveVS> VertexShader(ShaderMap);
+		TShaderMapRef<FImGuiPrimitivePS> PixelShader(ShaderMap);
+		PSOInitializer.BoundShaderState.VertexDeclarationRHI = GImGuiVertexDeclaration.PrimitiveVertexDeclarationRHI;
+		PSOInitializer.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+		PSOInitializer.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
+	}
+	else
+	{
+		TShaderMapRef<FImGuiVS> VertexShader(ShaderMap, VertexPermutationVector);
+		TShaderMapRef<FImGuiPS> PixelShader(ShaderMap, PixelPermutationVector);
+		const bool bAuxStream = Key.bMultiTexture || Key.bShaderClip;
+		if (Key.bPackedVertices)
+		{
+			PSOInitializer.BoundShaderState.VertexDeclarationRHI = bAuxStream ? GImGuiVertexDeclaration.PackedMultiTextureVertexDeclarationRHI : GImGuiVertexDeclaration.PackedVertexDeclarationRHI;
+		}
+		else
+		{
+			PSOInitializer.BoundShaderState.VertexDeclarationRHI = bAuxStream ? GImGuiVertexDeclaration.MultiTextureVertexDeclarationRHI : GImGuiVertexDeclaration.VertexDeclarationRHI;
+		}
+		PSOInitializer.BoundShaderState.VertexShaderRHI = VertexShader.GetVertexShader();
+		PSOInitializer.BoundShaderState.PixelShaderRHI = PixelShader.GetPixelShader();
+	}
+	PSOInitializer.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+	PSOInitializer.BlendState = GetBlendState(Key.BlendMode);
+	PSOInitializer.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+
+	//Another thread may have built the same key while we were
+	FWriteScopeLock WriteLock(CachedPipelineStatesLock);
+	TUniquePtr<FGraphicsPipelineStateInitializer>& CachedInitializer = CachedPipelineStates.FindOrAdd(Key);
+	if (!CachedInitializer.IsValid())
+	{
+		CachedInitializer = MakeUnique<FGraphicsPipelineStateInitializer>(PSOInitializer);
+	}
+	return *CachedInitializer;
+}
+
+void UnrealImGui::PrecachePipelineStates(FRHICommandList& RHICmdList, ERHIFeatureLevel::Type FeatureLevel, const FRHITexture* RenderTarget, EImGuiTextureKind FontTextureKind)
+{
+	check(IsInRenderingThread());
+
+	if (RenderTarget == nullptr)
+	{
+		return;
+	}
+
+	auto PrecacheKey = [&RHICmdList](const FImGuiPipelineKey& Key)
+	{
+		bool bCached;
+		{
+			FReadScopeLock ReadLock(CachedPipelineStatesLock);
+			bCached = CachedPipelineStates.Contains(Key);
+		}
+		if (!bCached)
+		{
+			PipelineStateCache::GetAndOrCreateGraphicsPipelineState(RHICmdList, GetPipelineState(Key), EApplyRendertargetOption::DoNothing);
+		}
+	};
+
+	const EImGuiBlendMode BlendModes[] = { EImGuiBlendMode::AlphaBlend, EImGuiBlendMode::Opaque };
+	//User textures always use Color, the font atlas only needs its own pipelines when it isn't a plain RGBA texture
+	const EImGuiTextureKind TextureKinds[] = { EImGuiTextureKind::Color, FontTextureKind };
+	const int32 NumTextureKinds = FontTextureKind != EImGuiTextureKind::Color ? UE_ARRAY_COUNT(TextureKinds) : 1;
+	const bool bShaderClip = UseShaderClip(FeatureLevel);
+	const bool bPackedVertices = UsePackedVertices();
+	const bool bAnalyticAA = UseAnalyticAA();
+
+	for (const EImGuiBlendMode BlendMode : BlendModes)
+	{
+		for (int32 TextureKindIndex = 0; TextureKindIndex < NumTextureKinds; ++TextureKindIndex)
+		{
+			const EImGuiTextureKind TextureKind = TextureKinds[TextureKindIndex];
+			for (const bool bMultiTexture : { false, true })
+			{
+				//Only the font atlas gets the coverage test in regular mode
+				const bool bKeyAnalyticAA = bAnalyticAA && (bMultiTexture || TextureKindIndex == NumTextureKinds - 1);
+				PrecacheKey(FImGuiPipelineKey(FeatureLevel, RenderTarget, BlendMode, TextureKind, bMultiTexture, false, bShaderClip, bPackedVertices, bKeyAnalyticAA));
+			}
+		}
+	}
+
+	if (UseGpuPrimitives())
+	{
+		PrecacheKey(FImGuiPipelineKey(FeatureLevel, RenderTarget, EImGuiBlendMode::AlphaBlend, EImGuiTextureKind::Color, false, true));
+	}
+}
+
+void UnrealImGui::ResetPipelineCache()
+{
+	check(IsInRenderingThread());
+	FWriteScopeLock WriteLock(CachedPipelineStatesLock);
+	CachedPipelineStates.Reset();
+}
@@ -0,0 +1,113 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderResource.h"
+#include "RHI.h"
+#include "RHIResources.h"
+
+namespace UnrealImGui
+{
+	enum class EImGuiBlendMode : uint8
+	{
+		AlphaBlend,	//Regular ImGui blending
+		Opaque,		//Ignores the source alpha, for previewing textures whose alpha channel isn't meant as opacity
+		Overlay,	//Regular ImGui blending into a cleared overlay, accumulating coverage in alpha so it can be composited later (see FImGuiOverlayCache)
+	};
+
+	enum class EImGuiTextureKind : uint8
+	{
+		Color,		//RGBA texture, sampled as is
+		FontAlpha8,	//Coverage-only font atlas (PF_G8), expanded to white + alpha in the shader
+		FontSdf,	//PF_G8 font atlas holding signed distances (ImFontAtlasFlags_SignedDistanceField)
+	};
+
+	inline bool IsAlpha8Font(EImGuiTextureKind Kind) { return Kind == EImGuiTextureKind::FontAlpha8; }
+	inline bool IsSdfFont(EImGuiTextureKind Kind) { return Kind == EImGuiTextureKind::FontSdf; }
+
+	//Everything that selects a distinct pipeline state for the ImGui pass
+	struct FImGuiPipelineKey
+	{
+		ERHIFeatureLevel::Type FeatureLevel = ERHIFeatureLevel::Num;
+		EPixelFormat RenderTargetFormat = PF_Unknown;
+		ETextureCreateFlags RenderTargetFlags = TexCreate_None;
+		uint8 NumSamples = 1;
+		EImGuiBlendMode BlendMode = EImGuiBlendMode::AlphaBlend;
+		EImGuiTextureKind TextureKind = EImGuiTextureKind::Color;
+		bool bMultiTexture = false;
+		bool bPrimitives = false;	//GPU primitive shaders, only BlendMode applies
+		bool bShaderClip = false;
+		bool bPackedVertices = false;
+		bool bAnalyticAA = false;
+
+		FImGuiPipelineKey() = default;
+		FImGuiPipelineKey(ERHIFeatureLevel::Type InFeatureLevel, const FRHITexture* RenderTarget, EImGuiBlendMode InBlendMode, EImGuiTextureKind InTextureKind, bool bInMultiTexture = false, bool bInPrimitives = false, bool bInShaderClip = false, bool bInPackedVertices = false, bool bInAnalyticAA = false);
+
+		bool operator==(const FImGuiPipelineKey& Other) const
+		{
+			return FeatureLevel == Other.FeatureLevel
+				&& RenderTargetFormat == Other.RenderTargetFormat
+				&& RenderTargetFlags == Other.RenderTargetFlags
+				&& NumSamples == Other.NumSamples
+				&& BlendMode == Other.BlendMode
+				&& TextureKind == Other.TextureKind
+				&& bMultiTexture == Other.bMultiTexture
+				&& bPrimitives == Other.bPrimitives
+				&& bShaderClip == Other.bShaderClip
+				&& bPackedVertices == Other.bPackedVertices
+				&& bAnalyticAA == Other.bAnalyticAA;
+		}
+
+		friend uint32 GetTypeHash(const FImGuiPipelineKey& Key)
+		{
+			uint32 Hash = GetTypeHash(static_cast<uint8>(Key.FeatureLevel));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.RenderTargetFormat)));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<uint64>(Key.RenderTargetFlags)));
+			Hash = HashCombine(Hash, GetTypeHash(Key.NumSamples));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.BlendMode)));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.TextureKind)));
+			Hash = HashCombine(Hash, GetTypeHash(Key.bMultiTexture));
+			Hash = HashCombine(Hash, GetTypeHash(Key.bPrimitives));
+			Hash = HashCombine(Hash, GetTypeHash(Key.bShaderClip));
+			Hash = HashCombine(Hash, GetTypeHash(Key.bPackedVertices));
+			return HashCombine(Hash, GetTypeHash(Key.bAnalyticAA));
+		}
+	};
+
+	//Vertex Declarations matching ImDrawVert, created once with the RHI
+	class FImGuiVertexDeclaration : public FRenderResource
+	{
+	public:
+		FVertexDeclarationRHIRef VertexDeclarationRHI;
+		FVertexDeclarationRHIRef MultiTextureVertexDeclarationRHI; //Adds FUnrealImGuiVertexAux as a second stream, for multi-texture and shader clipping modes
+		FVertexDeclarationRHIRef PackedVertexDeclarationRHI; //FUnrealImGuiPackedVertex instead of ImDrawVert
+		FVertexDeclarationRHIRef PackedMultiTextureVertexDeclarationRHI;
+		FVertexDeclarationRHIRef PrimitiveVertexDeclarationRHI; //FUnrealImGuiPrimitive per instance, for the GPU primitive shaders
+
+		virtual void InitRHI() override;
+		virtual void ReleaseRHI() override;
+	};
+
+	extern TGlobalResource<FImGuiVertexDeclaration> GImGuiVertexDeclaration;
+
+	//Render Thread (or a parallel recording task): Returns the pipeline state for Key, building it the first time the key is seen
+	const FGraphicsPipelineStateInitializer& GetPipelineState(const FImGuiPipelineKey& Key);
+
+	//Render Thread: Creates the pipeline states we'll need to draw into RenderTarget, so the first visible frame doesn't have to compile them.
+	//FontTextureKind is how the font atlas is sampled (Color for a plain RGBA atlas).
+	void PrecachePipelineStates(FRHICommandList& RHICmdList, ERHIFeatureLevel::Type FeatureLevel, const FRHITexture* RenderTarget, EImGuiTextureKind FontTextureKind);
+
+	//Returns true if clip rects should be applied in the pixel shader (imgui.shaderclip) when drawing at FeatureLevel.
+	//Platforms without the shader clipping permutations fall back to scissor rects.
+	bool UseShaderClip(ERHIFeatureLevel::Type FeatureLevel);
+
+	//Returns true if vertices should be uploaded as FUnrealImGuiPackedVertex (imgui.packedvertices)
+	bool UsePackedVertices();
+
+	//Returns true if ImGui should emit analytically anti-aliased strokes (imgui.analyticaa)
+	bool UseAnalyticAA();
+
+	//Render Thread: Forgets all cached pipeline states
+	void ResetPipelineCache();
+}
@@ -0,0 +1,65 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiPrimitives.h"
+#include "DynamicRHI.h"
+
+IMPLEMENT_SHADER_TYPE(, FImGuiPrimitiveVS, TEXT("/Plugin/UnrealImGui/Private/ImGuiPrimitives.usf"), TEXT("MainVS"), SF_Vertex);
+IMPLEMENT_SHADER_TYPE(, FImGuiPrimitivePS, TEXT("/Plugin/UnrealImGui/Private/ImGuiPrimitives.usf"), TEXT("MainPS"), SF_Pixel);
+
+namespace UnrealImGui
+{
+	static bool GGpuPrimitives = true;
+	static FAutoConsoleVariableRef CVarGpuPrimitives = FAutoConsoleVariableRef(
+		TEXT("imgui.gpuprimitives"),
+		GGpuPrimitives,
+		TEXT("If enabled, UnrealImGui::AddLine/AddPolyline/AddCircle/AddCircleFilled are expanded and anti-aliased on the GPU\n")
+		TEXT("0: Tessellate them on the game thread like the ImDrawList functions (always the case with NullRHI)"),
+		ECVF_Default
+	);
+}
+
+void UnrealImGui::PrimitiveBatchCallback(const ImDrawList* DrawList, const ImDrawCmd* Cmd)
+{
+	checkNoEntry();
+}
+
+bool UnrealImGui::UseGpuPrimitives()
+{
+	return GGpuPrimitives && !GUsingNullRHI;
+}
+
+void UnrealImGui::FImGuiPrimitiveBuffer::NewFrame()
+{
+	check(IsInGameThread());
+	Primitives.Reset();
+	Batches.Reset();
+}
+
+void UnrealImGui::FImGuiPrimitiveBuffer::Add(ImDrawList* DrawList, const FUnrealImGuiPrimitive& Primitive)
+{
+	check(IsInGameThread());
+
+	//AddCallback() leaves an empty command after the callback, which picks up any clip rect or texture change.
+	//If that's still all there is after our last batch, and nothing went into the buffer since, the batch can simply grow.
+	const int32 NumCmds = DrawList->CmdBuffer.Size;
+	if (NumCmds >= 2)
+	{
+		const ImDrawCmd& LastCmd = DrawList->CmdBuffer[NumCmds - 1];
+		const ImDrawCmd& BatchCmd = DrawList->CmdBuffer[NumCmds - 2];
+		if (BatchCmd.UserCallback == PrimitiveBatchCallback && LastCmd.UserCallback == nullptr && LastCmd.ElemCount == 0
+			&& FMemory::Memcmp(&LastCmd.ClipRect, &BatchCmd.ClipRect, sizeof(ImVec4)) == 0)
+		{
+			FBatch& Batch = Batches[static_cast<int32>(reinterpret_cast<UPTRINT>(BatchCmd.UserCallbackData))];
+			if (Batch.FirstPrimitive + Batch.NumPrimitives == static_cast<uint32>(Primitives.Num()))
+			{
+				Primitives.Add(Primitive);
+				++Batch.NumPrimitives;
+				return;
+			}
+		}
+	}
+
+	const int32 BatchIndex = Batches.Add({ static_cast<uint32>(Primitives.Num()), 1 });
+	Primitives.Add(Primitive);
+	DrawList->AddCallback(PrimitiveBatchCallback, reinterpret_cast<void*>(static_cast<UPTRINT>(BatchIndex)));
+}
@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnrealImGui.h"
+
+namespace UnrealImGui
+{
+	//Marks a draw command as a batch of GPU primitives. Never called, the renderer draws the batch instead.
+	void PrimitiveBatchCallback(const ImDrawList* DrawList, const ImDrawCmd* Cmd);
+
+	//Returns true if AddLine/AddCircle... should record GPU primitives rather than tessellate on the game thread
+	bool UseGpuPrimitives();
+
+	//Game Thread: GPU primitives added to ImGui's draw lists this frame.
+	//Each batch is a PrimitiveBatchCallback command in its draw list, so primitives keep their order relative to regular ImGui drawing.
+	class FImGuiPrimitiveBuffer
+	{
+	public:
+		struct FBatch
+		{
+			uint32 FirstPrimitive;
+			uint32 NumPrimitives;
+		};
+
+		//Forgets last frame's primitives. Call before ImGui::NewFrame()
+		void NewFrame();
+
+		//Appends Primitive to DrawList, extending the list's last batch when nothing else was drawn since
+		void Add(ImDrawList* DrawList, const FUnrealImGuiPrimitive& Primitive);
+
+		const TArray<FUnrealImGuiPrimitive>& GetPrimitives() const { return Primitives; }
+
+		//Cmd must be a PrimitiveBatchCallback command from this frame
+		const FBatch& GetBatch(const ImDrawCmd& Cmd) const { return Batches[static_cast<int32>(reinterpret_cast<UPTRINT>(Cmd.UserCallbackData))]; }
+
+	private:
+		TArray<FUnrealImGuiPrimitive> Primitives;
+		TArray<FBatch> Batches;
+	};
+}
+
+//Expands each FUnrealImGuiPrimitive instance into a quad covering it
+class FImGuiPrimitiveVS : public FGlobalShader
+{
+	DECLARE_SHADER_TYPE(FImGuiPrimitiveVS, Global);
+	SHADER_USE_PARAMETER_STRUCT(FImGuiPrimitiveVS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_REF(FImGuiUniformParameters, ImGuiUniforms)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return true;
+	}
+};
+
+//Anti-aliases primitives from their distance to the shape's edge
+class FImGuiPrimitivePS : public FGlobalShader
+{
+	DECLARE_SHADER_TYPE(FImGuiPrimitivePS, Global);
+
+	FImGuiPrimitivePS() { }
+	FImGuiPrimitivePS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+		: FGlobalShader(Initializer)
+	{
+	}
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return true;
+	}
+};
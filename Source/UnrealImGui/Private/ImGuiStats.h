@@ -0,0 +1,36 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("UnrealImGui"), STATGROUP_UnrealImGui, STATCAT_Advanced);
+
+//Geometry Buffers
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Uploaded"), STAT_ImGuiBytesUploaded, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Saved By Packed Vertices"), STAT_ImGuiPackedVertexBytesSaved, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Buffer Reallocations"), STAT_ImGuiBufferReallocations, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Buffer Ring Stalls"), STAT_ImGuiBufferRingStalls, STATGROUP_UnrealImGui, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Geometry Buffer Memory"), STAT_ImGuiBufferMemory, STATGROUP_UnrealImGui, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Geometry Buffer Peak"), STAT_ImGuiBufferPeakMemory, STATGROUP_UnrealImGui, );
+
+//Draw Submission
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Draw Calls"), STAT_ImGuiDrawCalls, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Merged Commands"), STAT_ImGuiMergedCommands, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Culled Commands"), STAT_ImGuiCulledCommands, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Texture Binds"), STAT_ImGuiTextureBinds, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Unresolved Texture Commands"), STAT_ImGuiUnresolvedTextureCommands, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("GPU Primitives"), STAT_ImGuiGpuPrimitives, STATGROUP_UnrealImGui, );
+
+//Debug Draw
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Debug Draw Primitives"), STAT_ImGuiDebugDrawPrimitives, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Debug Draw Primitives Dropped"), STAT_ImGuiDebugDrawDropped, STATGROUP_UnrealImGui, );
+
+//Frame Reuse
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Unchanged Frames"), STAT_ImGuiUnchangedFrames, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Overlay Composites"), STAT_ImGuiOverlayComposites, STATGROUP_UnrealImGui, );
+
+//Glyph Cache
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Glyphs Rasterized"), STAT_ImGuiGlyphsRasterized, STATGROUP_UnrealImGui, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Glyph Pages Evicted"), STAT_ImGuiGlyphPagesEvicted, STATGROUP_UnrealImGui, );
@@ -0,0 +1,29 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+//Single implementation of stb_rect_pack and stb_truetype, shared by ImGui's font atlas builder and our glyph cache (see imconfig.h)
+
+#include "UnrealImGui.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+THIRD_PARTY_INCLUDES_START
+
+#define STBRP_ASSERT(x)     do { IM_ASSERT(x); } while (0)
+#define STBRP_SORT          ImQsort
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "ThirdParty/ImGui/imstb_rectpack.h"
+
+//stb_truetype only allocates scratch memory it frees itself, and the atlas is rasterized from several threads (ImFontAtlas::BuildParallelFor).
+//IM_ALLOC counts allocations in the current ImGui context, which isn't thread safe, so go straight to the engine allocator.
+#define STBTT_malloc(x,u)   ((void)(u), FMemory::Malloc(x))
+#define STBTT_free(x,u)     ((void)(u), FMemory::Free(x))
+#define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
+#define STBTT_fmod(x,y)     ImFmod(x,y)
+#define STBTT_sqrt(x)       ImSqrt(x)
+#define STBTT_pow(x,y)      ImPow(x,y)
+#define STBTT_fabs(x)       ImFabs(x)
+#define STBTT_ifloor(x)     ((int)ImFloorStd(x))
+#define STBTT_iceil(x)      ((int)ImCeil(x))
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "ThirdParty/ImGui/imstb_truetype.h"
+
+THIRD_PARTY_INCLUDES_END
@@ -0,0 +1,167 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "ImGuiTextureRegistry.h"
+#include "Engine/Texture.h"
+#include "TextureResource.h"
+
+ImTextureID UnrealImGui::FImGuiTextureRegistry::Register(UTexture* Texture, bool bIgnoreAlpha)
+{
+	check(IsInGameThread());
+
+	if (Texture == nullptr)
+	{
+		UE_LOG(LogUnrealImGui, Warning, TEXT("Attempting to register a null UTexture with UnrealImGui"));
+		return ImTextureID();
+	}
+
+	//Registering the same texture again (i.e. every frame from blueprint) hands back the same ID
+	const TPair<TWeakObjectPtr<UTexture>, bool> Key(Texture, bIgnoreAlpha);
+	if (const int32* ExistingIndex = TextureToEntry.Find(Key))
+	{
+		return ToTextureId(*ExistingIndex);
+	}
+
+	FEntry Entry;
+	Entry.Texture = Texture;
+	Entry.bIgnoreAlpha = bIgnoreAlpha;
+	const int32 EntryIndex = AddEntry(MoveTemp(Entry));
+	if (EntryIndex == INDEX_NONE)
+	{
+		return ImTextureID();
+	}
+	TextureToEntry.Add(Key, EntryIndex);
+	return ToTextureId(EntryIndex);
+}
+
+ImTextureID UnrealImGui::FImGuiTextureRegistry::Register(FRHITexture* Texture, bool bIgnoreAlpha)
+{
+	check(IsInGameThread());
+
+	if (Texture == nullptr)
+	{
+		UE_LOG(LogUnrealImGui, Warning, TEXT("Attempting to register a null FRHITexture with UnrealImGui"));
+		return ImTextureID();
+	}
+
+	const TPair<FRHITexture*, bool> Key(Texture, bIgnoreAlpha);
+	if (const int32* ExistingIndex = TextureRHIToEntry.Find(Key))
+	{
+		return ToTextureId(*ExistingIndex);
+	}
+
+	FEntry Entry;
+	Entry.TextureRHI = Texture;
+	Entry.bIgnoreAlpha = bIgnoreAlpha;
+	const int32 EntryIndex = AddEntry(MoveTemp(Entry));
+	if (EntryIndex == INDEX_NONE)
+	{
+		return ImTextureID();
+	}
+	TextureRHIToEntry.Add(Key, EntryIndex);
+	return ToTextureId(EntryIndex);
+}
+
+void UnrealImGui::FImGuiTextureRegistry::Unregister(ImTextureID TextureId)
+{
+	check(IsInGameThread());
+
+	const int32 EntryIndex = FindEntry(TextureId);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FEntry& Entry = Entries[EntryIndex];
+	if (Entry.TextureRHI.IsValid())
+	{
+		TextureRHIToEntry.Remove(TPair<FRHITexture*, bool>(Entry.TextureRHI.GetReference(), Entry.bIgnoreAlpha));
+	}
+	else
+	{
+		TextureToEntry.Remove(TPair<TWeakObjectPtr<UTexture>, bool>(Entry.Texture, Entry.bIgnoreAlpha));
+	}
+	RemoveEntry(EntryIndex);
+}
+
+void UnrealImGui::FImGuiTextureRegistry::Reset()
+{
+	//Generations are kept, so IDs from before the reset stay invalid
+	for (TSparseArray<FEntry>::TConstIterator It(Entries); It; ++It)
+	{
+		Generations[It.GetIndex()] = (Generations[It.GetIndex()] + 1) & GenerationMask;
+	}
+	Entries.Empty();
+	TextureToEntry.Empty();
+	TextureRHIToEntry.Empty();
+}
+
+void UnrealImGui::FImGuiTextureRegistry::NewFrame()
+{
+	check(IsInGameThread());
+
+	for (auto It = TextureToEntry.CreateIterator(); It; ++It)
+	{
+		if (It.Key().Key.IsStale())
+		{
+			RemoveEntry(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+int32 UnrealImGui::FImGuiTextureRegistry::FindEntry(ImTextureID TextureId) const
+{
+	const int32 EntryIndex = ToEntryIndex(TextureId);
+	return Entries.IsValidIndex(EntryIndex) && Generations[EntryIndex] == ToGeneration(TextureId) ? EntryIndex : INDEX_NONE;
+}
+
+int32 UnrealImGui::FImGuiTextureRegistry::AddEntry(FEntry&& Entry)
+{
+	const int32 EntryIndex = Entries.Add(MoveTemp(Entry));
+	if (static_cast<UPTRINT>(EntryIndex + 1) > EntryIndexMask)
+	{
+		UE_LOG(LogUnrealImGui, Warning, TEXT("Too many textures registered with UnrealImGui, are they being unregistered?"));
+		Entries.RemoveAt(EntryIndex);
+		return INDEX_NONE;
+	}
+	if (EntryIndex >= Generations.Num())
+	{
+		Generations.SetNumZeroed(EntryIndex + 1);
+	}
+	return EntryIndex;
+}
+
+void UnrealImGui::FImGuiTextureRegistry::RemoveEntry(int32 EntryIndex)
+{
+	Entries.RemoveAt(EntryIndex);
+	Generations[EntryIndex] = (Generations[EntryIndex] + 1) & GenerationMask;
+}
+
+bool UnrealImGui::FImGuiTextureRegistry::Resolve(ImTextureID TextureId, FUnrealImGuiTexture& OutTexture) const
+{
+	OutTexture = FUnrealImGuiTexture();
+	if (TextureId == ImTextureID())
+	{
+		OutTexture.bFontAtlas = true;
+		return true;
+	}
+
+	const int32 EntryIndex = FindEntry(TextureId);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FEntry& Entry = Entries[EntryIndex];
+	OutTexture.bIgnoreAlpha = Entry.bIgnoreAlpha;
+	if (Entry.TextureRHI.IsValid())
+	{
+		OutTexture.TextureRHI = Entry.TextureRHI;
+		return true;
+	}
+
+	//The resource is released on the render thread after any frame we've already queued, so it's safe to hand over the pointer
+	const UTexture* Texture = Entry.Texture.Get();
+	OutTexture.Resource = Texture != nullptr ? Texture->GetResource() : nullptr;
+	return OutTexture.Resource != nullptr;
+}
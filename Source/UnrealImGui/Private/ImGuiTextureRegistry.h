@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "UnrealImGui.h"
+
+class UTexture;
+
+namespace UnrealImGui
+{
+	//Game Thread: Maps the ImTextureIDs handed out to ImGui to engine textures.
+	//ImTextureID 0 is the font atlas, registered textures start at 1.
+	//An ID holds its entry's slot and the generation of that slot. Unregistering bumps the generation, so an ID kept
+	//after UnregisterTexture() resolves to nothing instead of to whichever texture reuses the slot.
+	class FImGuiTextureRegistry
+	{
+	public:
+		ImTextureID Register(UTexture* Texture, bool bIgnoreAlpha);
+		ImTextureID Register(FRHITexture* Texture, bool bIgnoreAlpha);
+		void Unregister(ImTextureID TextureId);
+		void Reset();
+
+		//Drops the entries of textures that were garbage collected, ImguiImage() registers textures every frame and never unregisters them.
+		//Call before ImGui::NewFrame()
+		void NewFrame();
+
+		//Fills out what the render thread needs to bind TextureId. Returns false if TextureId isn't (or is no longer) valid.
+		bool Resolve(ImTextureID TextureId, FUnrealImGuiTexture& OutTexture) const;
+
+	private:
+		struct FEntry
+		{
+			TWeakObjectPtr<UTexture> Texture;
+			FTextureRHIRef TextureRHI;
+			bool bIgnoreAlpha = false;
+		};
+
+		static constexpr int32 EntryIndexBits = 20;
+		static constexpr UPTRINT EntryIndexMask = (UPTRINT(1) << EntryIndexBits) - 1;
+		static constexpr uint32 GenerationMask = static_cast<uint32>(~UPTRINT(0) >> EntryIndexBits);
+
+		ImTextureID ToTextureId(int32 EntryIndex) const { return reinterpret_cast<ImTextureID>((static_cast<UPTRINT>(Generations[EntryIndex]) << EntryIndexBits) | static_cast<UPTRINT>(EntryIndex + 1)); }
+		static int32 ToEntryIndex(ImTextureID TextureId) { return static_cast<int32>(reinterpret_cast<UPTRINT>(TextureId) & EntryIndexMask) - 1; }
+		static uint32 ToGeneration(ImTextureID TextureId) { return static_cast<uint32>(reinterpret_cast<UPTRINT>(TextureId) >> EntryIndexBits); }
+
+		//Returns the index of the entry TextureId refers to, or INDEX_NONE if it was unregistered
+		int32 FindEntry(ImTextureID TextureId) const;
+		int32 AddEntry(FEntry&& Entry);
+		void RemoveEntry(int32 EntryIndex);
+
+		TSparseArray<FEntry> Entries;
+		//Per slot of Entries, kept when the slot is freed. Wraps at GenerationMask, what fits in an ImTextureID above the entry index.
+		TArray<uint32> Generations;
+		//The same texture registered with and without bIgnoreAlpha gets two entries, so each caller draws it the way it asked for
+		TMap<TPair<TWeakObjectPtr<UTexture>, bool>, int32> TextureToEntry;
+		//Entries hold a reference to their RHI texture, so its address can't be reused by another texture while it's registered
+		TMap<TPair<FRHITexture*, bool>, int32> TextureRHIToEntry;
+	};
+}
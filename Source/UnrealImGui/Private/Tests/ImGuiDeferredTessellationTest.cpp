@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealImGui.h"
+#include "Misc/AutomationTest.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnrealImGui
+{
+	//Every shape that goes through AddPolyline or AddConvexPolyFilled, with thin, thick, fractional and textured line widths
+	static void DrawDeferrableShapes(ImDrawList& DrawList)
+	{
+		const ImU32 Col = IM_COL32(255, 128, 64, 200);
+		for (const float Thickness : { 1.0f, 1.5f, 2.0f, 7.0f, 80.0f })
+		{
+			DrawList.AddLine(ImVec2(10.0f, 10.0f), ImVec2(310.0f, 95.5f), Col, Thickness);
+			DrawList.AddRect(ImVec2(20.0f, 30.0f), ImVec2(200.0f, 150.0f), Col, 8.0f, ImDrawCornerFlags_All, Thickness);
+			DrawList.AddCircle(ImVec2(400.0f, 300.0f), 50.0f, Col, 0, Thickness);
+			DrawList.AddNgon(ImVec2(120.0f, 400.0f), 30.0f, Col, 5, Thickness);
+			DrawList.AddBezierCubic(ImVec2(0.0f, 0.0f), ImVec2(100.0f, 300.0f), ImVec2(300.0f, -100.0f), ImVec2(500.0f, 200.0f), Col, Thickness);
+			DrawList.AddTriangle(ImVec2(5.0f, 5.0f), ImVec2(60.0f, 5.0f), ImVec2(30.0f, 50.0f), Col, Thickness);
+		}
+		DrawList.AddRectFilled(ImVec2(20.0f, 30.0f), ImVec2(200.0f, 150.0f), Col, 12.0f);
+		DrawList.AddCircleFilled(ImVec2(400.0f, 300.0f), 50.0f, Col);
+		DrawList.AddNgonFilled(ImVec2(120.0f, 400.0f), 30.0f, Col, 7);
+		DrawList.AddTriangleFilled(ImVec2(5.0f, 5.0f), ImVec2(60.0f, 5.0f), ImVec2(30.0f, 50.0f), Col);
+		DrawList.PathArcTo(ImVec2(250.0f, 250.0f), 40.0f, 0.0f, 4.0f);
+		DrawList.PathStroke(Col, false, 3.0f);
+
+		//Degenerate input: repeated points and a single point
+		const ImVec2 Repeated[] = { ImVec2(1.0f, 1.0f), ImVec2(1.0f, 1.0f), ImVec2(50.0f, 1.0f), ImVec2(50.0f, 1.0f) };
+		DrawList.AddPolyline(Repeated, UE_ARRAY_COUNT(Repeated), Col, true, 2.0f);
+		DrawList.AddConvexPolyFilled(Repeated, UE_ARRAY_COUNT(Repeated), Col);
+		DrawList.AddPolyline(Repeated, 1, Col, false, 1.0f);
+
+		//Interleaved with geometry that is written immediately, and across draw commands
+		DrawList.PrimReserve(6, 4);
+		DrawList.PrimRect(ImVec2(0.0f, 0.0f), ImVec2(4.0f, 4.0f), Col);
+		DrawList.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(256.0f, 256.0f));
+		DrawList.AddLine(ImVec2(10.0f, 200.0f), ImVec2(250.0f, 20.0f), Col, 3.0f);
+		DrawList.PopClipRect();
+		DrawList.AddCircleFilled(ImVec2(40.0f, 40.0f), 20.0f, Col, 64);
+	}
+
+	//Records DrawDeferrableShapes into DrawList, deferred or not, leaving its buffers complete
+	static void RecordDeferrableShapes(ImDrawList& DrawList, ImDrawListFlags Flags, bool bDefer)
+	{
+		DrawList._ResetForNewFrame();
+		DrawList.Flags = Flags | (bDefer ? ImDrawListFlags_DeferTessellation : ImDrawListFlags_None);
+		DrawList.PushClipRectFullScreen();
+		DrawDeferrableShapes(DrawList);
+		DrawList.PopClipRect();
+		DrawList._TessellateDeferred();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiDeferredTessellationTest, "UnrealImGui.DeferredTessellation.MatchesImmediate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiDeferredTessellationTest::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	//The textured line path needs an atlas for its baked UVs
+	ImFontAtlas FontAtlas;
+	FontAtlas.AddFontDefault();
+	FontAtlas.Build();
+
+	ImDrawListSharedData SharedData;
+	SharedData.ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, 8192.0f, 8192.0f);
+	SharedData.CurveTessellationTol = 1.25f;
+	SharedData.SetCircleSegmentMaxError(1.6f);
+	SharedData.TexUvWhitePixel = FontAtlas.TexUvWhitePixel;
+	SharedData.TexUvLines = FontAtlas.TexUvLines;
+
+	const ImDrawListFlags FlagCombinations[] =
+	{
+		ImDrawListFlags_None,
+		ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill,
+		ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill,
+		ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedLinesAnalytic | ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset,
+	};
+
+	for (const ImDrawListFlags Flags : FlagCombinations)
+	{
+		ImDrawList Immediate(&SharedData);
+		ImDrawList Deferred(&SharedData);
+		RecordDeferrableShapes(Immediate, Flags, false);
+		RecordDeferrableShapes(Deferred, Flags, true);
+
+		const FString Context = FString::Printf(TEXT("flags 0x%x"), Flags);
+		if (!TestEqual(*(Context + TEXT(" vertex count")), Deferred.VtxBuffer.Size, Immediate.VtxBuffer.Size)
+			|| !TestEqual(*(Context + TEXT(" index count")), Deferred.IdxBuffer.Size, Immediate.IdxBuffer.Size)
+			|| !TestEqual(*(Context + TEXT(" command count")), Deferred.CmdBuffer.Size, Immediate.CmdBuffer.Size))
+		{
+			continue;
+		}
+		TestTrue(*(Context + TEXT(" vertices")), FMemory::Memcmp(Deferred.VtxBuffer.Data, Immediate.VtxBuffer.Data, Immediate.VtxBuffer.size_in_bytes()) == 0);
+		TestTrue(*(Context + TEXT(" indices")), FMemory::Memcmp(Deferred.IdxBuffer.Data, Immediate.IdxBuffer.Data, Immediate.IdxBuffer.size_in_bytes()) == 0);
+		for (int32 CmdIndex = 0; CmdIndex < Immediate.CmdBuffer.Size; CmdIndex++)
+		{
+			const ImDrawCmd& ImmediateCmd = Immediate.CmdBuffer[CmdIndex];
+			const ImDrawCmd& DeferredCmd = Deferred.CmdBuffer[CmdIndex];
+			TestTrue(*(Context + TEXT(" command ranges")), DeferredCmd.ElemCount == ImmediateCmd.ElemCount && DeferredCmd.IdxOffset == ImmediateCmd.IdxOffset && DeferredCmd.VtxOffset == ImmediateCmd.VtxOffset);
+		}
+	}
+	return true;
+}
+
+#endif
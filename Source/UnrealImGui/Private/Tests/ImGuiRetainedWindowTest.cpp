@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealImGui.h"
+#include "Misc/AutomationTest.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnrealImGui
+{
+	//Runs frames in an ImGui context of its own, so tests don't disturb the plugin's
+	class FImGuiTestContext
+	{
+	public:
+		FImGuiTestContext()
+			: PreviousContext(ImGui::GetCurrentContext())
+		{
+			FontAtlas.AddFontDefault();
+			FontAtlas.Build();
+			Context = ImGui::CreateContext(&FontAtlas);
+			ImGui::SetCurrentContext(Context);
+
+			ImGuiIO& IO = ImGui::GetIO();
+			IO.IniFilename = nullptr;
+			IO.DisplaySize = ImVec2(1280.0f, 720.0f);
+			IO.DeltaTime = 1.0f / 60.0f;
+		}
+
+		~FImGuiTestContext()
+		{
+			ImGui::DestroyContext(Context);
+			ImGui::SetCurrentContext(PreviousContext);
+		}
+
+		template<typename FuncType>
+		void RunFrame(FuncType&& Func)
+		{
+			ImGui::NewFrame();
+			Func();
+			ImGui::Render();
+		}
+
+	private:
+		ImGuiContext* PreviousContext;
+		ImGuiContext* Context;
+		ImFontAtlas FontAtlas;
+	};
+
+	//A retained window that is appended to once per frame, like a log window filled from several places
+	static ImGuiWindow* DrawRetainedWindow(bool bWithChild)
+	{
+		ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+		ImGui::SetNextWindowSize(ImVec2(300.0f, 200.0f), ImGuiCond_Always);
+		ImGui::SetNextWindowContentHash(bWithChild ? 2 : 1);
+		if (ImGui::Begin("Retained", nullptr, ImGuiWindowFlags_Retained))
+		{
+			ImGui::TextUnformatted("first");
+			if (bWithChild)
+			{
+				ImGui::BeginChild("Child", ImVec2(100.0f, 50.0f));
+				ImGui::TextUnformatted("child");
+				ImGui::EndChild();
+			}
+		}
+		ImGui::End();
+
+		if (ImGui::Begin("Retained"))
+		{
+			ImGui::TextUnformatted("appended");
+		}
+		ImGui::End();
+		return ImGui::FindWindowByName("Retained");
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiRetainedWindowTest, "UnrealImGui.RetainedWindow.ReplaysRecordedFrame", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiRetainedWindowTest::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	FImGuiTestContext TestContext;
+
+	//Both parts of the window are recorded, and the replay draws what the last recorded frame drew
+	int32 RecordedVtxCount = 0;
+	bool bRetained = false;
+	for (int32 Frame = 0; Frame < 8 && !bRetained; Frame++)
+	{
+		TestContext.RunFrame([&]()
+		{
+			const ImGuiWindow* Window = DrawRetainedWindow(false);
+			bRetained = Window->RetainedThisFrame;
+			if (bRetained)
+			{
+				TestEqual(TEXT("Replayed vertex count"), Window->DrawList->VtxBuffer.Size, RecordedVtxCount);
+			}
+			else
+			{
+				RecordedVtxCount = Window->DrawList->VtxBuffer.Size;
+			}
+		});
+	}
+	if (!TestTrue(TEXT("Appended window is retained"), bRetained))
+	{
+		return false;
+	}
+
+	//A child window stops the replay, and the window is retained again once it's gone
+	for (int32 Frame = 0; Frame < 3; Frame++)
+	{
+		TestContext.RunFrame([&]()
+		{
+			TestFalse(TEXT("Retained with a child window"), DrawRetainedWindow(true)->RetainedThisFrame);
+		});
+	}
+	bRetained = false;
+	for (int32 Frame = 0; Frame < 4 && !bRetained; Frame++)
+	{
+		TestContext.RunFrame([&]()
+		{
+			bRetained = DrawRetainedWindow(false)->RetainedThisFrame;
+		});
+	}
+	return TestTrue(TEXT("Retained again after the child window is gone"), bRetained);
+}
+
+#endif
@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealImGui.h"
+#include "Misc/AutomationTest.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnrealImGui
+{
+	//Polyline points with the cases the kernels branch on: repeated points (zero length segments), tiny and huge coordinates
+	static TArray<ImVec2> MakeTessellationPoints(int32 NumPoints, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		TArray<ImVec2> Points;
+		Points.Reserve(NumPoints);
+		for (int32 PointIndex = 0; PointIndex < NumPoints; PointIndex++)
+		{
+			const int32 Kind = Random.RandRange(0, 9);
+			if (Kind == 0 && PointIndex > 0)
+			{
+				Points.Add(Points.Last());
+			}
+			else
+			{
+				const float Range = (Kind == 1) ? 0.001f : (Kind == 2) ? 100000.0f : 2000.0f;
+				Points.Add(ImVec2(Random.FRandRange(-Range, Range), Random.FRandRange(-Range, Range)));
+			}
+		}
+		return Points;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiSimdTessellationTest, "UnrealImGui.SimdTessellation.MatchesScalar", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiSimdTessellationTest::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	//Every count up to a few vector iterations, so every length of scalar tail is covered
+	for (int32 NumPoints = 1; NumPoints <= 67; NumPoints++)
+	{
+		const TArray<ImVec2> Points = MakeTessellationPoints(NumPoints, NumPoints);
+		for (const bool bClosed : { false, true })
+		{
+			const int32 NumSegments = bClosed ? NumPoints : NumPoints - 1;
+			TArray<ImVec2> Normals, ScalarNormals, Averaged, ScalarAveraged;
+			Normals.SetNumZeroed(NumPoints);
+			ScalarNormals.SetNumZeroed(NumPoints);
+			Averaged.SetNumZeroed(NumPoints);
+			ScalarAveraged.SetNumZeroed(NumPoints);
+
+			ImComputeSegmentNormals(Points.GetData(), NumPoints, NumSegments, Normals.GetData());
+			ImComputeSegmentNormalsScalar(Points.GetData(), NumPoints, NumSegments, ScalarNormals.GetData());
+			ImComputeAveragedNormals(ScalarNormals.GetData(), NumPoints, Averaged.GetData());
+			ImComputeAveragedNormalsScalar(ScalarNormals.GetData(), NumPoints, ScalarAveraged.GetData());
+
+			const FString Context = FString::Printf(TEXT("%d points, %s"), NumPoints, bClosed ? TEXT("closed") : TEXT("open"));
+			if (!TestTrue(*(Context + TEXT(" segment normals")), FMemory::Memcmp(Normals.GetData(), ScalarNormals.GetData(), NumPoints * sizeof(ImVec2)) == 0)
+				|| !TestTrue(*(Context + TEXT(" averaged normals")), FMemory::Memcmp(Averaged.GetData(), ScalarAveraged.GetData(), NumPoints * sizeof(ImVec2)) == 0))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiSimdTessellationBenchmark, "UnrealImGui.SimdTessellation.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FImGuiSimdTessellationBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	//A plot line, the largest polylines ImGui usually draws
+	constexpr int32 NumPoints = 1000;
+	constexpr int32 NumIterations = 2000;
+	const TArray<ImVec2> Points = MakeTessellationPoints(NumPoints, 1234);
+	TArray<ImVec2> Normals, Averaged;
+	Normals.SetNumZeroed(NumPoints);
+	Averaged.SetNumZeroed(NumPoints);
+
+	auto TimePerPolyline = [&](auto ComputeSegmentNormals, auto ComputeAveragedNormals)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+		{
+			ComputeSegmentNormals(Points.GetData(), NumPoints, NumPoints, Normals.GetData());
+			ComputeAveragedNormals(Normals.GetData(), NumPoints, Averaged.GetData());
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumIterations;
+	};
+
+	const double ScalarUs = TimePerPolyline(&ImComputeSegmentNormalsScalar, &ImComputeAveragedNormalsScalar);
+	const double SimdUs = TimePerPolyline(&ImComputeSegmentNormals, &ImComputeAveragedNormals);
+
+	AddInfo(FString::Printf(TEXT("Normals of a %d point closed polyline: %.2f us scalar, %.2f us with IMGUI_SIMD_TESSELLATION=%d"), NumPoints, ScalarUs, SimdUs, IMGUI_SIMD_TESSELLATION));
+	return true;
+}
+
+#endif
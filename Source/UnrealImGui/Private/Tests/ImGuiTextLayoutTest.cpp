@@ -0,0 +1,319 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "UnrealImGui.h"
+#include "Misc/AutomationTest.h"
+#include "ThirdParty/ImGui/imgui_internal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UnrealImGui
+{
+	//Width of a single line measured one character at a time, the way CalcTextSizeA did before its ASCII fast path
+	static float CalcLineWidthPerCharacter(const ImFont& Font, float Size, float MaxWidth, const char* Text, const char* TextEnd)
+	{
+		const float Scale = Size / Font.FontSize;
+		float LineWidth = 0.0f;
+		for (const char* S = Text; S < TextEnd; )
+		{
+			unsigned int C = static_cast<unsigned char>(*S);
+			S += C < 0x80 ? 1 : ImTextCharFromUtf8(&C, S, TextEnd);
+			if (C == 0)
+			{
+				break;
+			}
+			if (C == '\r')
+			{
+				continue;
+			}
+			const float CharWidth = Font.GetCharAdvance(static_cast<ImWchar>(C)) * Scale;
+			if (LineWidth + CharWidth >= MaxWidth)
+			{
+				break;
+			}
+			LineWidth += CharWidth;
+		}
+		return LineWidth;
+	}
+
+	//Size of wrapped text measured one character at a time, the way CalcTextSizeA did before its size cache and ASCII fast path
+	static ImVec2 CalcWrappedSizePerCharacter(const ImFont& Font, float Size, float WrapWidth, const char* Text, const char* TextEnd)
+	{
+		const float Scale = Size / Font.FontSize;
+		ImVec2 TextSize(0.0f, 0.0f);
+		float LineWidth = 0.0f;
+		const char* WordWrapEol = nullptr;
+		for (const char* S = Text; S < TextEnd; )
+		{
+			if (WordWrapEol == nullptr)
+			{
+				WordWrapEol = Font.CalcWordWrapPositionA(Scale, S, TextEnd, WrapWidth - LineWidth);
+				WordWrapEol += WordWrapEol == S ? 1 : 0;
+			}
+			if (S >= WordWrapEol)
+			{
+				TextSize.x = FMath::Max(TextSize.x, LineWidth);
+				TextSize.y += Size;
+				LineWidth = 0.0f;
+				WordWrapEol = nullptr;
+				while (S < TextEnd && ImCharIsBlankA(*S))
+				{
+					S++;
+				}
+				S += S < TextEnd && *S == '\n' ? 1 : 0;
+				continue;
+			}
+
+			unsigned int C = static_cast<unsigned char>(*S);
+			S += C < 0x80 ? 1 : ImTextCharFromUtf8(&C, S, TextEnd);
+			if (C == 0)
+			{
+				break;
+			}
+			if (C == '\n')
+			{
+				TextSize.x = FMath::Max(TextSize.x, LineWidth);
+				TextSize.y += Size;
+				LineWidth = 0.0f;
+			}
+			else if (C != '\r')
+			{
+				LineWidth += Font.GetCharAdvance(static_cast<ImWchar>(C)) * Scale;
+			}
+		}
+		TextSize.x = FMath::Max(TextSize.x, LineWidth);
+		if (LineWidth > 0.0f || TextSize.y == 0.0f)
+		{
+			TextSize.y += Size;
+		}
+		return TextSize;
+	}
+
+	//Renders Text at the origin. Fine clipping against a clip rect around everything leaves the quads as they are,
+	//but takes RenderText down its per-character path.
+	static void RenderTextLine(ImDrawList& DrawList, const ImFont& Font, float Size, float WrapWidth, const char* Text, const char* TextEnd, bool bPerCharacter)
+	{
+		const ImVec4 ClipRect(-8192.0f, -8192.0f, 8192.0f, 8192.0f);
+		Font.RenderText(&DrawList, Size, ImVec2(0.0f, 0.0f), IM_COL32_WHITE, ClipRect, Text, TextEnd, WrapWidth, bPerCharacter);
+	}
+
+	//Log console lines: mostly ASCII, some with UTF-8 and tabs. Not null terminated.
+	static TArray<TArray<ANSICHAR>> MakeTextLayoutLines(int32 NumLines)
+	{
+		static const ANSICHAR* const Words[] = { "LogTemp:", "Warning:", "frame", "0x7ffe12", "caf\xC3\xA9", "\t", "update()", "took", "1.25ms", "[Render]", "\xE2\x86\x92", "ok" };
+		FRandomStream Random(1234);
+		TArray<TArray<ANSICHAR>> Lines;
+		for (int32 LineIndex = 0; LineIndex < NumLines; LineIndex++)
+		{
+			TArray<ANSICHAR>& Line = Lines.AddDefaulted_GetRef();
+			const int32 NumWords = Random.RandRange(1, 40);
+			for (int32 WordIndex = 0; WordIndex < NumWords; WordIndex++)
+			{
+				const ANSICHAR* Word = Words[Random.RandRange(0, UE_ARRAY_COUNT(Words) - 1)];
+				Line.Append(Word, FCStringAnsi::Strlen(Word));
+				Line.Add(' ');
+			}
+		}
+		return Lines;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiTextLayoutTest, "UnrealImGui.TextLayout.MatchesPerCharacter", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiTextLayoutTest::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	ImFontAtlas FontAtlas;
+	const ImFont& Font = *FontAtlas.AddFontDefault();
+	FontAtlas.Build();
+
+	for (const TArray<ANSICHAR>& Line : MakeTextLayoutLines(500))
+	{
+		const char* Text = Line.GetData();
+		const char* TextEnd = Text + Line.Num();
+		for (const float Size : { 13.0f, 17.5f })
+		{
+			//Unwrapped: the ASCII runs must add up the same advances, in the same order
+			const ImVec2 TextSize = Font.CalcTextSizeA(Size, FLT_MAX, 0.0f, Text, TextEnd);
+			if (!TestTrue(TEXT("Unwrapped width"), TextSize.x == CalcLineWidthPerCharacter(Font, Size, FLT_MAX, Text, TextEnd)))
+			{
+				return false;
+			}
+
+			//Wrapped: measured and cached sizes must both match measuring one character at a time
+			const ImVec2 ExpectedSize = CalcWrappedSizePerCharacter(Font, Size, 200.0f, Text, TextEnd);
+			const char* Remaining = nullptr;
+			const char* CachedRemaining = nullptr;
+			Font.ClearTextSizeCache();
+			const ImVec2 WrappedSize = Font.CalcTextSizeA(Size, FLT_MAX, 200.0f, Text, TextEnd, &Remaining);
+			const ImVec2 CachedSize = Font.CalcTextSizeA(Size, FLT_MAX, 200.0f, Text, TextEnd, &CachedRemaining);
+			if (!TestTrue(TEXT("Wrapped size"), WrappedSize.x == ExpectedSize.x && WrappedSize.y == ExpectedSize.y && Remaining == TextEnd)
+				|| !TestTrue(TEXT("Cached wrapped size"), CachedSize.x == ExpectedSize.x && CachedSize.y == ExpectedSize.y && CachedRemaining == TextEnd))
+			{
+				return false;
+			}
+		}
+	}
+
+	//RenderText: the batched ASCII runs must write the same quads as the per-character path
+	ImDrawListSharedData SharedData;
+	SharedData.ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, 8192.0f, 8192.0f);
+	ImDrawList Batched(&SharedData);
+	ImDrawList PerCharacter(&SharedData);
+	for (const TArray<ANSICHAR>& Line : MakeTextLayoutLines(200))
+	{
+		for (const float WrapWidth : { 0.0f, 200.0f })
+		{
+			Batched._ResetForNewFrame();
+			PerCharacter._ResetForNewFrame();
+			for (const float Size : { 13.0f, 17.5f })
+			{
+				RenderTextLine(Batched, Font, Size, WrapWidth, Line.GetData(), Line.GetData() + Line.Num(), false);
+				RenderTextLine(PerCharacter, Font, Size, WrapWidth, Line.GetData(), Line.GetData() + Line.Num(), true);
+			}
+			if (!TestEqual(TEXT("RenderText vertex count"), Batched.VtxBuffer.Size, PerCharacter.VtxBuffer.Size)
+				|| !TestEqual(TEXT("RenderText index count"), Batched.IdxBuffer.Size, PerCharacter.IdxBuffer.Size)
+				|| !TestTrue(TEXT("RenderText vertices"), FMemory::Memcmp(Batched.VtxBuffer.Data, PerCharacter.VtxBuffer.Data, PerCharacter.VtxBuffer.size_in_bytes()) == 0)
+				|| !TestTrue(TEXT("RenderText indices"), FMemory::Memcmp(Batched.IdxBuffer.Data, PerCharacter.IdxBuffer.Data, PerCharacter.IdxBuffer.size_in_bytes()) == 0))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+namespace UnrealImGui
+{
+	//Stands in for FImGuiGlyphCache: fails to load the arrow until bLoadArrow is set, like a glyph cache out of space for the frame
+	struct FTestGlyphLoader
+	{
+		bool bLoadArrow = false;
+
+		static bool LoadGlyph(ImFont* Font, ImWchar Codepoint)
+		{
+			const FTestGlyphLoader& Loader = *static_cast<const FTestGlyphLoader*>(Font->ContainerAtlas->GlyphLoaderUserData);
+			if (Codepoint != 0x2192 || !Loader.bLoadArrow)
+			{
+				return false;
+			}
+			Font->AddGlyph(nullptr, Codepoint, 0.0f, 0.0f, 20.0f, 10.0f, 0.0f, 0.0f, 0.0f, 0.0f, 25.0f);
+			Font->GrowIndex(Codepoint + 1);
+			Font->IndexLookup[Codepoint] = static_cast<ImWchar>(Font->Glyphs.Size - 1);
+			Font->IndexAdvanceX[Codepoint] = 25.0f;
+			return true;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiTextSizeCacheTest, "UnrealImGui.TextLayout.SizeCacheInvalidation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FImGuiTextSizeCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	ImFontAtlas FontAtlas;
+	ImFont& Font = *FontAtlas.AddFontDefault();
+	FontAtlas.Build();
+
+	static const ANSICHAR Text[] = "LogTemp: frame \xE2\x86\x92 update() took 1.25ms, then the next frame took about as long";
+	const char* TextEnd = Text + UE_ARRAY_COUNT(Text) - 1;
+	auto CalcWrappedSize = [&Font, TextEnd]() { return Font.CalcTextSizeA(13.0f, FLT_MAX, 120.0f, Text, TextEnd); };
+	auto MatchesPerCharacter = [&Font, TextEnd](const ImVec2& TextSize)
+	{
+		const ImVec2 ExpectedSize = CalcWrappedSizePerCharacter(Font, 13.0f, 120.0f, Text, TextEnd);
+		return TextSize.x == ExpectedSize.x && TextSize.y == ExpectedSize.y;
+	};
+
+	//BuildLookupTable() picks up changed advances, so it must drop the sizes measured with the old ones
+	Font.ClearTextSizeCache();
+	const ImVec2 OriginalSize = CalcWrappedSize();
+	TestTrue(TEXT("Measured size"), MatchesPerCharacter(OriginalSize));
+	ImFontGlyph* Glyph = const_cast<ImFontGlyph*>(Font.FindGlyphNoFallback('e'));
+	Glyph->AdvanceX *= 3.0f;
+	Font.BuildLookupTable();
+	const ImVec2 WiderSize = CalcWrappedSize();
+	TestTrue(TEXT("Size after BuildLookupTable()"), MatchesPerCharacter(WiderSize) && (WiderSize.x != OriginalSize.x || WiderSize.y != OriginalSize.y));
+	Glyph->AdvanceX /= 3.0f;
+	Font.BuildLookupTable();
+
+	//A size measured while a glyph failed to load used the fallback advance, it must not be reused once the glyph loads
+	FTestGlyphLoader Loader;
+	FontAtlas.GlyphLoader = &FTestGlyphLoader::LoadGlyph;
+	FontAtlas.GlyphLoaderUserData = &Loader;
+	const ImVec2 FallbackSize = CalcWrappedSize();
+	TestTrue(TEXT("Size with the fallback glyph"), MatchesPerCharacter(FallbackSize));
+	Loader.bLoadArrow = true;
+	const ImVec2 LoadedSize = CalcWrappedSize();
+	TestTrue(TEXT("Size after loading the glyph"), MatchesPerCharacter(LoadedSize) && (LoadedSize.x != FallbackSize.x || LoadedSize.y != FallbackSize.y));
+	TestTrue(TEXT("Cached size after loading the glyph"), MatchesPerCharacter(CalcWrappedSize()));
+	FontAtlas.GlyphLoader = nullptr;
+	FontAtlas.GlyphLoaderUserData = nullptr;
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FImGuiTextLayoutBenchmark, "UnrealImGui.TextLayout.Benchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FImGuiTextLayoutBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace UnrealImGui;
+
+	ImFontAtlas FontAtlas;
+	const ImFont& Font = *FontAtlas.AddFontDefault();
+	FontAtlas.Build();
+
+	//A scrolled log console: each frame measures the same visible lines again
+	const TArray<TArray<ANSICHAR>> Lines = MakeTextLayoutLines(100);
+	constexpr int32 NumFrames = 200;
+	constexpr float WrapWidth = 300.0f;
+
+	//Keeps the results alive, so the compiler can't drop the loops
+	float Checksum = 0.0f;
+	auto TimePerFrame = [&Lines, &Checksum](auto&& Measure)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			for (const TArray<ANSICHAR>& Line : Lines)
+			{
+				Checksum += Measure(Line.GetData(), Line.GetData() + Line.Num());
+			}
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumFrames;
+	};
+
+	const double PerCharacterUs = TimePerFrame([&Font](const char* Text, const char* TextEnd) { return CalcLineWidthPerCharacter(Font, 13.0f, FLT_MAX, Text, TextEnd); });
+	const double AsciiRunsUs = TimePerFrame([&Font](const char* Text, const char* TextEnd) { return Font.CalcTextSizeA(13.0f, FLT_MAX, 0.0f, Text, TextEnd).x; });
+	const double WrappedUncachedUs = TimePerFrame([&Font](const char* Text, const char* TextEnd) { Font.ClearTextSizeCache(); return Font.CalcTextSizeA(13.0f, FLT_MAX, WrapWidth, Text, TextEnd).y; });
+	Font.ClearTextSizeCache();
+	const double WrappedCachedUs = TimePerFrame([&Font](const char* Text, const char* TextEnd) { return Font.CalcTextSizeA(13.0f, FLT_MAX, WrapWidth, Text, TextEnd).y; });
+
+	AddInfo(FString::Printf(TEXT("CalcTextSizeA, %d lines: %.1f us per frame one character at a time, %.1f us with ASCII runs"), Lines.Num(), PerCharacterUs, AsciiRunsUs));
+	//RenderText appends to one draw list per frame, like a window drawing its visible lines
+	ImDrawListSharedData SharedData;
+	SharedData.ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, 8192.0f, 8192.0f);
+	ImDrawList DrawList(&SharedData);
+	auto TimeRenderTextPerFrame = [&Lines, &Font, &DrawList, &Checksum](bool bPerCharacter)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; Frame++)
+		{
+			DrawList._ResetForNewFrame();
+			for (const TArray<ANSICHAR>& Line : Lines)
+			{
+				RenderTextLine(DrawList, Font, 13.0f, 0.0f, Line.GetData(), Line.GetData() + Line.Num(), bPerCharacter);
+			}
+			Checksum += DrawList.VtxBuffer.Size;
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumFrames;
+	};
+	const double RenderPerCharacterUs = TimeRenderTextPerFrame(true);
+	const double RenderBatchedUs = TimeRenderTextPerFrame(false);
+
+	AddInfo(FString::Printf(TEXT("CalcTextSizeA wrapped at %.0f, %d lines: %.1f us per frame measured, %.1f us through the size cache"), WrapWidth, Lines.Num(), WrappedUncachedUs, WrappedCachedUs));
+	AddInfo(FString::Printf(TEXT("RenderText, %d lines: %.1f us per frame one character at a time, %.1f us with batched ASCII runs"), Lines.Num(), RenderPerCharacterUs, RenderBatchedUs));
+	AddInfo(FString::Printf(TEXT("Checksum %f"), Checksum));
+	return true;
+}
+
+#endif
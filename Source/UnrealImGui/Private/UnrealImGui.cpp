@@ -1,9 +1,28 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UnrealImGui.h"
+#include "ImGuiBufferRing.h"
+#include "ImGuiDebugDraw.h"
+#include "ImGuiDrawDataPool.h"
+#include "ImGuiFontAtlasCache.h"
+#include "ImGuiGlyphCache.h"
+#include "ImGuiOverlayCache.h"
+#include "ImGuiPipelineCache.h"
+#include "ImGuiPrimitives.h"
+#include "ImGuiTextureRegistry.h"
+#include "ImGuiStats.h"
 #include "Interfaces/IPluginManager.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Hash/CityHash.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderTargetPool.h"
 
 #include "Kismet/GameplayStatics.h"
+#include "Engine/LocalPlayer.h"
+#include "SceneView.h"
+#include "TextureResource.h"
 #define IMGUI_IMPLEMENTATION
 #include "ThirdParty/ImGui/misc/single_file/imgui_single_file.h"
 
@@ -11,6 +30,25 @@
 
 DEFINE_LOG_CATEGORY(LogUnrealImGui);
 
+DEFINE_STAT(STAT_ImGuiBytesUploaded);
+DEFINE_STAT(STAT_ImGuiPackedVertexBytesSaved);
+DEFINE_STAT(STAT_ImGuiBufferReallocations);
+DEFINE_STAT(STAT_ImGuiBufferRingStalls);
+DEFINE_STAT(STAT_ImGuiBufferMemory);
+DEFINE_STAT(STAT_ImGuiBufferPeakMemory);
+DEFINE_STAT(STAT_ImGuiDrawCalls);
+DEFINE_STAT(STAT_ImGuiMergedCommands);
+DEFINE_STAT(STAT_ImGuiCulledCommands);
+DEFINE_STAT(STAT_ImGuiTextureBinds);
+DEFINE_STAT(STAT_ImGuiUnresolvedTextureCommands);
+DEFINE_STAT(STAT_ImGuiGpuPrimitives);
+DEFINE_STAT(STAT_ImGuiDebugDrawPrimitives);
+DEFINE_STAT(STAT_ImGuiDebugDrawDropped);
+DEFINE_STAT(STAT_ImGuiUnchangedFrames);
+DEFINE_STAT(STAT_ImGuiOverlayComposites);
+DEFINE_STAT(STAT_ImGuiGlyphsRasterized);
+DEFINE_STAT(STAT_ImGuiGlyphPagesEvicted);
+
 namespace UnrealImGui
 {
 	static bool GShowImGui = true;
@@ -21,6 +59,134 @@ namespace UnrealImGui
 		TEXT("0: Disable, 1: Show"),
 		ECVF_Cheat
 	);
+
+	static bool GMultiTexture = false;
+	static FAutoConsoleVariableRef CVarMultiTexture = FAutoConsoleVariableRef(
+		TEXT("imgui.multitexture"),
+		GMultiTexture,
+		TEXT("If enabled, binds several textures at once and picks one per vertex, so draws using different textures can be merged\n")
+		TEXT("Useful for windows showing many images (render target browsers, atlas viewers)"),
+		ECVF_Default
+	);
+
+	static bool GShaderClip = false;
+	static FAutoConsoleVariableRef CVarShaderClip = FAutoConsoleVariableRef(
+		TEXT("imgui.shaderclip"),
+		GShaderClip,
+		TEXT("If enabled, clip rects are applied in the pixel shader instead of with scissor rects, so draws using different clip rects can be merged\n")
+		TEXT("Useful for UIs with many small clipped regions (tables, columns, child windows), at the cost of a discard in the pixel shader. Ignored below SM5 (ES3.1)"),
+		ECVF_Default
+	);
+
+	static bool GPackedVertices = false;
+	static FAutoConsoleVariableRef CVarPackedVertices = FAutoConsoleVariableRef(
+		TEXT("imgui.packedvertices"),
+		GPackedVertices,
+		TEXT("If enabled, vertices are uploaded in a 12 byte format (fixed point positions, snorm16 UVs) instead of ImDrawVert's 20 bytes\n")
+		TEXT("Frames with vertices the format can't hold (more than 4096 pixels off the display, UVs outside [-1, 1]) are uploaded unpacked"),
+		ECVF_RenderThreadSafe
+	);
+
+	static bool GAnalyticAA = false;
+	static FAutoConsoleVariableRef CVarAnalyticAA = FAutoConsoleVariableRef(
+		TEXT("imgui.analyticaa"),
+		GAnalyticAA,
+		TEXT("If enabled, anti-aliased lines the font atlas has no baked texture for (thick, fractional width, or imgui.font.sdf) are emitted without fringe geometry,\n")
+		TEXT("and the pixel shader computes their coverage from the distance to the line's center. Halves the vertices of thick lines and borders"),
+		ECVF_Default
+	);
+
+	static bool GDeferredTessellation = false;
+	static FAutoConsoleVariableRef CVarDeferredTessellation = FAutoConsoleVariableRef(
+		TEXT("imgui.deferredtessellation"),
+		GDeferredTessellation,
+		TEXT("If enabled, widgets only record the lines, borders and filled shapes they draw, and ImGui::Render tessellates them on task graph workers, one job per window\n")
+		TEXT("Text and plain rectangles are still written as they're drawn. Windows split into channels (tables, columns) tessellate when switching channels"),
+		ECVF_Default
+	);
+
+	static bool GAlpha8FontAtlas = true;
+	static FAutoConsoleVariableRef CVarAlpha8FontAtlas = FAutoConsoleVariableRef(
+		TEXT("imgui.font.alpha8"),
+		GAlpha8FontAtlas,
+		TEXT("If enabled, the font atlas is stored as a single channel coverage texture (PF_G8) instead of RGBA, using a quarter of the memory\n")
+		TEXT("Read at initialization"),
+		ECVF_ReadOnly
+	);
+
+	static bool GDynamicGlyphs = false;
+	static FAutoConsoleVariableRef CVarDynamicGlyphs = FAutoConsoleVariableRef(
+		TEXT("imgui.font.dynamic"),
+		GDynamicGlyphs,
+		TEXT("If enabled, glyphs that weren't baked into the font atlas are rasterized the first time they're drawn, as long as one of the font's sources has them\n")
+		TEXT("Lets fonts be built with small glyph ranges (e.g. GetGlyphRangesDefault) and still display CJK text. Read at initialization"),
+		ECVF_ReadOnly
+	);
+
+	static int32 GDynamicGlyphPages = 16;
+	static FAutoConsoleVariableRef CVarDynamicGlyphPages = FAutoConsoleVariableRef(
+		TEXT("imgui.font.dynamic.pages"),
+		GDynamicGlyphPages,
+		TEXT("Number of 256x256 font atlas pages reserved for dynamic glyphs. The least recently used page is cleared when they're all full\n")
+		TEXT("Read at initialization"),
+		ECVF_ReadOnly
+	);
+	static constexpr int32 DynamicGlyphPageSize = 256;
+
+	static bool GFreeTypeFonts = WITH_IMGUI_FREETYPE != 0;
+	static FAutoConsoleVariableRef CVarFreeTypeFonts = FAutoConsoleVariableRef(
+		TEXT("imgui.font.freetype"),
+		GFreeTypeFonts,
+		TEXT("If enabled, fonts are rasterized with FreeType instead of stb_truetype. Only available, and on by default, when the module is built with FreeType (see UnrealImGui.Build.cs)\n")
+		TEXT("Read at initialization"),
+		ECVF_ReadOnly
+	);
+
+	static int32 GFreeTypeFlags = 0;
+	static FAutoConsoleVariableRef CVarFreeTypeFlags = FAutoConsoleVariableRef(
+		TEXT("imgui.font.freetype.flags"),
+		GFreeTypeFlags,
+		TEXT("ImGuiFreeType::RasterizerFlags applied to every font, e.g. 1: NoHinting, 8: LightHinting, 32: Bold\n")
+		TEXT("Read at initialization"),
+		ECVF_ReadOnly
+	);
+
+	static bool GSdfFonts = false;
+	static FAutoConsoleVariableRef CVarSdfFonts = FAutoConsoleVariableRef(
+		TEXT("imgui.font.sdf"),
+		GSdfFonts,
+		TEXT("If enabled, glyphs are stored as signed distance fields, so a single atlas stays sharp at any font scale (FontGlobalScale, SetWindowFontScale, DPI)\n")
+		TEXT("Always rasterized with stb_truetype into a single channel atlas, whatever imgui.font.alpha8 is set to, and incompatible with imgui.font.dynamic. Read at initialization"),
+		ECVF_ReadOnly
+	);
+
+	static int32 GParallelRecordingThreshold = 2048;
+	static FAutoConsoleVariableRef CVarParallelRecordingThreshold = FAutoConsoleVariableRef(
+		TEXT("imgui.parallel.threshold"),
+		GParallelRecordingThreshold,
+		TEXT("Frames with at least this many draw commands are split across several passes recorded in parallel on task graph workers\n")
+		TEXT("0: Always record on the render thread"),
+		ECVF_RenderThreadSafe
+	);
+	static constexpr int32 MinParallelCommandsPerPass = 256;
+
+	static bool GReuseUnchangedFrames = true;
+	static FAutoConsoleVariableRef CVarReuseUnchangedFrames = FAutoConsoleVariableRef(
+		TEXT("imgui.reuseframes"),
+		GReuseUnchangedFrames,
+		TEXT("If enabled, a frame whose draw data is identical to the previous one skips the copy for the render thread and draws from the geometry already uploaded\n")
+		TEXT("See also imgui.overlaycache"),
+		ECVF_Default
+	);
+
+	static bool GFontAtlasCache = true;
+	static FAutoConsoleVariableRef CVarFontAtlasCache = FAutoConsoleVariableRef(
+		TEXT("imgui.font.cache"),
+		GFontAtlasCache,
+		TEXT("If enabled, the built font atlas is saved under Saved/ImGui and reused by later launches with the same fonts and settings\n")
+		TEXT("Read at initialization"),
+		ECVF_ReadOnly
+	);
 }
 
 void FUnrealImGuiModule::StartupModule()
@@ -33,6 +199,7 @@ void FUnrealImGuiModule::StartupModule()
 	
 IMPLEMENT_MODULE(FUnrealImGuiModule, UnrealImGui)
 
+IMPLEMENT_GLOBAL_SHADER_PARAMETER_STRUCT(FImGuiUniformParameters, "ImGuiUniforms");
 IMPLEMENT_SHADER_TYPE(, FImGuiVS, TEXT("/Plugin/UnrealImGui/Private/ImGui.usf"), TEXT("MainVS"), SF_Vertex);
 IMPLEMENT_SHADER_TYPE(, FImGuiPS, TEXT("/Plugin/UnrealImGui/Private/ImGui.usf"), TEXT("MainPS"), SF_Pixel);
 
@@ -43,15 +210,248 @@ static FDelegateHandle BeginFrameDelegate;
 static FDelegateHandle ViewportRenderedDelegateHandle;
 static FDelegateHandle InputKeyDelegateHandle;
 static FDelegateHandle CloseRequestedDelegateHandle;
+static TUniquePtr<UnrealImGui::FImGuiDrawDataPool> DrawDataPool;
+static bool bPipelinesPrecached = false;
+static UnrealImGui::FImGuiTextureRegistry TextureRegistry;
+static UnrealImGui::FImGuiGlyphCache GlyphCache;
+static UnrealImGui::FImGuiPrimitiveBuffer PrimitiveBuffer;
+static uint64 LastQueuedContentHash = 0;
 //END GameThread Globals
 
+//BEGIN AnyThread Globals
+static UnrealImGui::FImGuiDebugDrawQueue DebugDrawQueue;
+//END AnyThread Globals
+
 //BEGIN RenderThread Globals
-FBufferRHIRef ImguiVertexBuffer;
-FBufferRHIRef ImguiIndexBuffer;
+UnrealImGui::FImGuiBufferRing ImGuiBufferRing;
 FTexture2DRHIRef ImGuiFontTexture;
 FSamplerStateRHIRef ImGuiFontSampler;
+static UnrealImGui::EImGuiTextureKind ImGuiFontTextureKind = UnrealImGui::EImGuiTextureKind::Color;
+static UnrealImGui::FUnrealImGuiDrawData* LastDrawData = nullptr; //Snapshot of the last frame that changed, drawn again by unchanged frames
+static UnrealImGui::FImGuiOverlayCache ImGuiOverlayCache;
 //END RenderThread Globals
 
+//Render Thread: Returns the RHI texture to bind for Texture, or nullptr if it doesn't exist (yet)
+static FRHITexture* ResolveTextureRHI(const UnrealImGui::FUnrealImGuiTexture& Texture)
+{
+	if (Texture.bFontAtlas)
+	{
+		return ImGuiFontTexture;
+	}
+	return Texture.Resource != nullptr ? Texture.Resource->TextureRHI.GetReference() : Texture.TextureRHI.GetReference();
+}
+
+bool UnrealImGui::UseShaderClip(ERHIFeatureLevel::Type FeatureLevel)
+{
+	return GShaderClip && SupportsShaderClip(FeatureLevel);
+}
+
+bool UnrealImGui::UsePackedVertices()
+{
+	return GPackedVertices;
+}
+
+bool UnrealImGui::UseAnalyticAA()
+{
+	return GAnalyticAA;
+}
+
+//Render Thread: Writes Vertices into Dst as FUnrealImGuiPackedVertex, positions relative to Origin.
+//Returns false as soon as a vertex doesn't fit the packed format, leaving Dst partially written.
+static bool PackVertices(const ImDrawVert* Vertices, int32 NumVertices, const ImVec2& Origin, UnrealImGui::FUnrealImGuiPackedVertex* Dst)
+{
+	using namespace UnrealImGui;
+	static_assert(sizeof(FUnrealImGuiPackedVertex) == 12, "Packed vertices should stay 12 bytes, update the vertex declaration and ImGui.usf");
+
+	for (int32 Index = 0; Index < NumVertices; ++Index)
+	{
+		const ImDrawVert& Vertex = Vertices[Index];
+		const float X = (Vertex.pos.x - Origin.x) * PackedPositionScale;
+		const float Y = (Vertex.pos.y - Origin.y) * PackedPositionScale;
+
+		//Written so NaNs fail too
+		if (!(X >= MIN_int16 && X <= MAX_int16 && Y >= MIN_int16 && Y <= MAX_int16
+			&& Vertex.uv.x >= -1.0f && Vertex.uv.x <= 1.0f && Vertex.uv.y >= -1.0f && Vertex.uv.y <= 1.0f))
+		{
+			return false;
+		}
+
+		FUnrealImGuiPackedVertex& Packed = Dst[Index];
+		Packed.Pos[0] = static_cast<int16>(FMath::RoundToInt(X));
+		Packed.Pos[1] = static_cast<int16>(FMath::RoundToInt(Y));
+		Packed.UV[0] = static_cast<int16>(FMath::RoundToInt(Vertex.uv.x * MAX_int16));
+		Packed.UV[1] = static_cast<int16>(FMath::RoundToInt(Vertex.uv.y * MAX_int16));
+		Packed.Col = Vertex.col;
+	}
+	return true;
+}
+
+//Render Thread: Projects Cmd's clip rect into framebuffer pixels, clamped to the render target. Returns false if nothing is left to draw.
+static bool GetScissorRect(const UnrealImGui::FUnrealImGuiDrawCmd& Cmd, const ImVec2& ClipOff, const ImVec2& ClipScale, const FIntPoint& TargetSize, FIntRect& OutRect)
+{
+	OutRect.Min.X = FMath::Clamp(FMath::TruncToInt((Cmd.ClipRect.x - ClipOff.x) * ClipScale.x), 0, TargetSize.X);
+	OutRect.Min.Y = FMath::Clamp(FMath::TruncToInt((Cmd.ClipRect.y - ClipOff.y) * ClipScale.y), 0, TargetSize.Y);
+	OutRect.Max.X = FMath::Clamp(FMath::TruncToInt((Cmd.ClipRect.z - ClipOff.x) * ClipScale.x), 0, TargetSize.X);
+	OutRect.Max.Y = FMath::Clamp(FMath::TruncToInt((Cmd.ClipRect.w - ClipOff.y) * ClipScale.y), 0, TargetSize.Y);
+	return OutRect.Max.X > OutRect.Min.X && OutRect.Max.Y > OutRect.Min.Y;
+}
+
+BEGIN_SHADER_PARAMETER_STRUCT(FImGuiFontUploadParameters, )
+	RDG_TEXTURE_ACCESS(FontAtlas, ERHIAccess::CopyDest)
+END_SHADER_PARAMETER_STRUCT()
+
+BEGIN_SHADER_PARAMETER_STRUCT(FImGuiPassParameters, )
+	RDG_TEXTURE_ACCESS(FontAtlas, ERHIAccess::SRVGraphics)
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, ClipRects)
+	RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+//Render Thread: Adds a copy pass writing glyphs rasterized since the last frame into the font atlas
+static void AddFontUploadPass(FRDGBuilder& GraphBuilder, FRDGTextureRef FontAtlas, TArray<UnrealImGui::FImGuiGlyphCache::FUpload>&& InGlyphUploads)
+{
+	if (InGlyphUploads.Num() == 0 || FontAtlas == nullptr)
+	{
+		return;
+	}
+
+	//Glyphs may have been written where the overlay has older ones
+	ImGuiOverlayCache.Invalidate();
+
+	//Owned by the graph so it outlives setup
+	const TArray<UnrealImGui::FImGuiGlyphCache::FUpload>& GlyphUploads = *GraphBuilder.AllocObject<TArray<UnrealImGui::FImGuiGlyphCache::FUpload>>(MoveTemp(InGlyphUploads));
+
+	FImGuiFontUploadParameters* PassParameters = GraphBuilder.AllocParameters<FImGuiFontUploadParameters>();
+	PassParameters->FontAtlas = FontAtlas;
+
+	GraphBuilder.AddPass(
+		RDG_EVENT_NAME("ImGuiGlyphUpload"),
+		PassParameters,
+		ERDGPassFlags::Copy,
+		[&GlyphUploads](FRHICommandListImmediate& RHICmdList)
+	{
+		//Same expansion ImGui uses for its RGBA32 atlas
+		const bool bExpandToRGBA = ImGuiFontTexture->GetFormat() == PF_R8G8B8A8;
+		TArray<uint32> ExpandedPixels;
+
+		for (const UnrealImGui::FImGuiGlyphCache::FUpload& Upload : GlyphUploads)
+		{
+			const FUpdateTextureRegion2D Region(Upload.X, Upload.Y, 0, 0, Upload.Width, Upload.Height);
+			if (bExpandToRGBA)
+			{
+				ExpandedPixels.SetNumUninitialized(Upload.Pixels.Num(), false);
+				for (int32 PixelIndex = 0; PixelIndex < Upload.Pixels.Num(); ++PixelIndex)
+				{
+					ExpandedPixels[PixelIndex] = IM_COL32(255, 255, 255, Upload.Pixels[PixelIndex]);
+				}
+				RHICmdList.UpdateTexture2D(ImGuiFontTexture, 0, Region, Upload.Width * sizeof(uint32), reinterpret_cast<const uint8*>(ExpandedPixels.GetData()));
+				INC_DWORD_STAT_BY(STAT_ImGuiBytesUploaded, ExpandedPixels.Num() * sizeof(uint32));
+			}
+			else
+			{
+				RHICmdList.UpdateTexture2D(ImGuiFontTexture, 0, Region, Upload.Width, Upload.Pixels.GetData());
+				INC_DWORD_STAT_BY(STAT_ImGuiBytesUploaded, Upload.Pixels.Num());
+			}
+		}
+	});
+}
+
+//Lets ImGui run jobs on task graph workers: one per source font when building the font atlas, one per draw list when tessellating deferred shapes
+static void TaskGraphParallelFor(int Count, void (*Job)(void* JobData, int Index), void* JobData)
+{
+	ParallelFor(Count, [Job, JobData](int32 Index)
+	{
+		Job(JobData, Index);
+	});
+}
+
+//Game Thread: Tells ImGui which optional rendering features to emit geometry for this frame, call before ImGui::NewFrame()
+static void UpdateBackendFlags()
+{
+	ImGuiIO& IO = ImGui::GetIO();
+	if (UnrealImGui::UseAnalyticAA())
+	{
+		IO.BackendFlags |= ImGuiBackendFlags_RendererHasAnalyticAA;
+	}
+	else
+	{
+		IO.BackendFlags &= ~ImGuiBackendFlags_RendererHasAnalyticAA;
+	}
+	IO.TessellationParallelFor = UnrealImGui::GDeferredTessellation ? TaskGraphParallelFor : nullptr;
+}
+
+//Game Thread: Hash of everything Render_GameThread would copy for the render thread, so identical frames can be detected without copying them
+static uint64 HashDrawData(const ImDrawData& DrawData, const UnrealImGui::FImGuiTextureRegistry& InTextureRegistry, const UnrealImGui::FImGuiPrimitiveBuffer& InPrimitiveBuffer, bool bMultiTexture, bool bShaderClip)
+{
+	const float Display[] = { DrawData.DisplayPos.x, DrawData.DisplayPos.y, DrawData.DisplaySize.x, DrawData.DisplaySize.y, DrawData.FramebufferScale.x, DrawData.FramebufferScale.y };
+	uint64 Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Display), sizeof(Display), (bMultiTexture ? 1 : 0) | (bShaderClip ? 2 : 0));
+
+	const TArray<UnrealImGui::FUnrealImGuiPrimitive>& Primitives = InPrimitiveBuffer.GetPrimitives();
+	Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Primitives.GetData()), Primitives.Num() * sizeof(UnrealImGui::FUnrealImGuiPrimitive), Hash);
+
+	bool bHashedTexture = false;
+	ImTextureID HashedTextureId = ImTextureID();
+	for (int32 ListIndex = 0; ListIndex < DrawData.CmdListsCount; ++ListIndex)
+	{
+		const ImDrawList* CmdList = DrawData.CmdLists[ListIndex];
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(CmdList->VtxBuffer.Data), CmdList->VtxBuffer.Size * sizeof(ImDrawVert), Hash);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(CmdList->IdxBuffer.Data), CmdList->IdxBuffer.Size * sizeof(ImDrawIdx), Hash);
+		//ImDrawCmd is zeroed on construction, so its padding is stable
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(CmdList->CmdBuffer.Data), CmdList->CmdBuffer.Size * sizeof(ImDrawCmd), Hash);
+
+		//The same ImTextureID can point to another resource (e.g. a UTexture whose resource was recreated)
+		for (const ImDrawCmd& Cmd : CmdList->CmdBuffer)
+		{
+			if (Cmd.UserCallback != nullptr || (bHashedTexture && Cmd.TextureId == HashedTextureId))
+			{
+				continue;
+			}
+			UnrealImGui::FUnrealImGuiTexture Texture;
+			const bool bValid = InTextureRegistry.Resolve(Cmd.TextureId, Texture);
+			const UPTRINT TextureState[] = { bValid, reinterpret_cast<UPTRINT>(Texture.Resource), reinterpret_cast<UPTRINT>(Texture.TextureRHI.GetReference()), Texture.bIgnoreAlpha };
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(TextureState), sizeof(TextureState), Hash);
+			bHashedTexture = true;
+			HashedTextureId = Cmd.TextureId;
+		}
+	}
+	return Hash != 0 ? Hash : 1;
+}
+
+//Game Thread: View the first local player looks through, which the World debug draw functions project with
+static bool GetDebugDrawView(UnrealImGui::FImGuiDebugDrawView& OutView)
+{
+	const APlayerController* PlayerController = UGameplayStatics::GetPlayerController(OwningGameViewportClient.Get(), 0);
+	const ULocalPlayer* LocalPlayer = PlayerController != nullptr ? PlayerController->GetLocalPlayer() : nullptr;
+	FSceneViewProjectionData ProjectionData;
+	if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr || !LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		return false;
+	}
+	OutView.ViewRect = ProjectionData.GetConstrainedViewRect();
+	OutView.ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	return true;
+}
+
+//Builds the ImGui pipeline states for Viewport's render target ahead of the first frame that actually shows ImGui
+static void PrecachePipelineStates_GameThread(const FViewport* Viewport)
+{
+	if (bPipelinesPrecached || Viewport == nullptr)
+	{
+		return;
+	}
+	bPipelinesPrecached = true;
+
+	const UWorld* World = OwningGameViewportClient.IsValid() ? OwningGameViewportClient->GetWorld() : nullptr;
+	const ERHIFeatureLevel::Type FeatureLevel = World != nullptr ? World->FeatureLevel.GetValue() : GMaxRHIFeatureLevel;
+
+	//Queued after InitImGuiCmd, so the font texture kind is known by then
+	ENQUEUE_RENDER_COMMAND(PrecacheImGuiPipelinesCmd)(
+		[Viewport, FeatureLevel](FRHICommandListImmediate& RHICmdList)
+		{
+			UnrealImGui::PrecachePipelineStates(RHICmdList, FeatureLevel, Viewport->GetRenderTargetTexture(), ImGuiFontTextureKind);
+		}
+	);
+}
+
 void UnrealImGui::Initialize(UGameViewportClient* InGameViewportClient)
 {
 	if (InGameViewportClient == nullptr)
@@ -66,6 +466,12 @@ void UnrealImGui::Initialize(UGameViewportClient* InGameViewportClient)
 
 	ImGuiContextPtr = ImGui::CreateContext();
 	OwningGameViewportClient = InGameViewportClient;
+	DebugDrawQueue.SetEnabled(true);
+	DrawDataPool = MakeUnique<FImGuiDrawDataPool>();
+	LastQueuedContentHash = 0;
+
+	//Draws honour ImDrawCmd::VtxOffset, so with 16-bit indices ImGui can keep filling a list past 64k vertices instead of asserting
+	ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
 	
 	const ImGuiIO& IO = ImGui::GetIO();
 
@@ -107,18 +513,70 @@ void UnrealImGui::Initialize(UGameViewportClient* InGameViewportClient)
 	//Get Font Texture Data, to be passed to the render thread
 	unsigned char* FontTexSrc = nullptr;
 	int32 Width,Height,BytesPerPixel;
-	IO.Fonts->GetTexDataAsRGBA32(&FontTexSrc, &Width, &Height, &BytesPerPixel);
 
-	const TArray<unsigned char> FontTextureData(FontTexSrc, Width * Height * BytesPerPixel);
+	IO.Fonts->BuildParallelFor = TaskGraphParallelFor;
+	if (GSdfFonts)
+	{
+		//Baked lines hold coverage, let ImGui draw thick lines as polygons instead
+		IO.Fonts->Flags |= ImFontAtlasFlags_SignedDistanceField | ImFontAtlasFlags_NoBakedLines;
+	}
+	const bool bSdfFontAtlas = (IO.Fonts->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+
+	FImGuiFontBuildSettings FontBuildSettings;
+	FontBuildSettings.Rasterizer = GFreeTypeFonts ? EImGuiFontRasterizer::FreeType : EImGuiFontRasterizer::StbTruetype;
+	FontBuildSettings.FreeTypeFlags = static_cast<uint32>(GFreeTypeFlags);
+	if (GFontAtlasCache)
+	{
+		BuildFontAtlasCached(*IO.Fonts, FontBuildSettings, FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ImGui")));
+	}
+	else
+	{
+		BuildFontAtlas(*IO.Fonts, FontBuildSettings);
+	}
+
+	//The glyph cache reserves its pages in the atlas, so it has to be set up before we upload it
+	if (GDynamicGlyphs && bSdfFontAtlas)
+	{
+		UE_LOG(LogUnrealImGui, Warning, TEXT("imgui.font.dynamic is ignored, dynamic glyphs aren't rasterized as distance fields"));
+	}
+	else if (GDynamicGlyphs)
+	{
+		IO.Fonts->GetTexDataAsAlpha8(&FontTexSrc, &Width, &Height, &BytesPerPixel);
+		GlyphCache.Initialize(*IO.Fonts, FMath::Max(GDynamicGlyphPages, 1), DynamicGlyphPageSize);
+	}
+
+	//Distance fields only need one channel, so SDF atlases are always PF_G8
+	const bool bAlpha8FontAtlas = GAlpha8FontAtlas || bSdfFontAtlas;
+	if (bAlpha8FontAtlas)
+	{
+		IO.Fonts->GetTexDataAsAlpha8(&FontTexSrc, &Width, &Height, &BytesPerPixel);
+	}
+	else
+	{
+		IO.Fonts->GetTexDataAsRGBA32(&FontTexSrc, &Width, &Height, &BytesPerPixel);
+	}
+	const EPixelFormat FontTextureFormat = bAlpha8FontAtlas ? PF_G8 : PF_R8G8B8A8;
+
+	//The render thread takes ownership of this copy, so ImGui's own pixels can be freed right away
+	TArray<unsigned char> FontTextureData(FontTexSrc, Width * Height * BytesPerPixel);
+	IO.Fonts->ClearTexData();
 
 	ENQUEUE_RENDER_COMMAND(InitImGuiCmd)(
-		[FontTextureData, Width, Height](FRHICommandListImmediate& RHICmdList)
+		[FontTextureData = MoveTemp(FontTextureData), FontTextureFormat, Width, Height, bSdfFontAtlas](FRHICommandListImmediate& RHICmdList)
 		{
-			Initialize_RenderThread(RHICmdList, FontTextureData, Width, Height);
+			Initialize_RenderThread(RHICmdList, FontTextureData, FontTextureFormat, Width, Height, bSdfFontAtlas);
 		}
 	);
 
+	//The viewport already exists if we're being initialized during gameplay, otherwise we'll precache when it first renders
+	bPipelinesPrecached = false;
+	PrecachePipelineStates_GameThread(InGameViewportClient->Viewport);
+
 	//Call New Frame Once Here to ensure we're properly initialized
+	UpdateBackendFlags();
+	GlyphCache.NewFrame();
+	PrimitiveBuffer.NewFrame();
+	TextureRegistry.NewFrame();
 	ImGui::NewFrame();
 
 	//Bind to mouse scroll axis key
@@ -139,6 +597,10 @@ void UnrealImGui::Initialize(UGameViewportClient* InGameViewportClient)
 			ImGui::GetIO().MouseWheel += LocalPlayerController->GetInputAxisKeyValue(EKeys::MouseWheelAxis) * ScrollSpeed;
 		}
 
+		UpdateBackendFlags();
+		GlyphCache.NewFrame();
+		PrimitiveBuffer.NewFrame();
+		TextureRegistry.NewFrame();
 		ImGui::NewFrame();
 	});
 	
@@ -147,11 +609,17 @@ void UnrealImGui::Initialize(UGameViewportClient* InGameViewportClient)
 		//Despite being accesed as a member, this delegate is triggered any time any viewport is rendered, so check that InViewport is the correct viewport
         if (OwningGameViewportClient.IsValid() && InViewport == OwningGameViewportClient->Viewport)
         {
+        	PrecachePipelineStates_GameThread(InViewport);
+
         	//If CVar true, render
 			if (GShowImGui)
 			{
 			    Render_GameThread(InViewport);
 			}
+			else
+			{
+				DebugDrawQueue.Discard();
+			}
         }
 	});
 	
@@ -182,28 +650,51 @@ void UnrealImGui::Initialize(UGameViewportClient* InGameViewportClient)
 	});
 }
 
-void UnrealImGui::Initialize_RenderThread(FRHICommandListImmediate& RHICmdList, const TArray<unsigned char>& FontTextureData, int32 Width, int32 Height)
+void UnrealImGui::Initialize_RenderThread(FRHICommandListImmediate& RHICmdList, const TArray<unsigned char>& FontTextureData, EPixelFormat FontTextureFormat, int32 Width, int32 Height, bool bSdfFontAtlas)
 {	
+	if (bSdfFontAtlas)
+	{
+		check(FontTextureFormat == PF_G8);
+		ImGuiFontTextureKind = EImGuiTextureKind::FontSdf;
+	}
+	else
+	{
+		ImGuiFontTextureKind = FontTextureFormat == PF_G8 ? EImGuiTextureKind::FontAlpha8 : EImGuiTextureKind::Color;
+	}
+
 	FRHITextureCreateDesc TextureCreateDesc = {};
 	TextureCreateDesc.SetExtent(Width, Height);
-	TextureCreateDesc.SetFormat(PF_R8G8B8A8);
+	TextureCreateDesc.SetFormat(FontTextureFormat);
 	TextureCreateDesc.SetNumMips(1);
 	TextureCreateDesc.SetNumSamples(1);
 	TextureCreateDesc.SetFlags(TexCreate_ShaderResource);
 	TextureCreateDesc.SetDebugName(TEXT("ImGuiFontTexture"));
 	ImGuiFontTexture = RHICreateTexture(TextureCreateDesc);
 
-	uint32 _DestStride;
-	unsigned char* TexDst = static_cast<unsigned char*>(RHICmdList.LockTexture2D(ImGuiFontTexture, 0, RLM_WriteOnly, _DestStride, false));
-	const size_t UploadSize = FontTextureData.Num() * sizeof(char);
-	FMemory::Memcpy(TexDst, FontTextureData.GetData(), UploadSize);
+	//Rows may be padded, especially for narrow formats like PF_G8
+	uint32 DestStride;
+	unsigned char* TexDst = static_cast<unsigned char*>(RHICmdList.LockTexture2D(ImGuiFontTexture, 0, RLM_WriteOnly, DestStride, false));
+	const uint32 SrcStride = Width * GPixelFormats[FontTextureFormat].BlockBytes;
+	if (DestStride == SrcStride)
+	{
+		FMemory::Memcpy(TexDst, FontTextureData.GetData(), FontTextureData.Num());
+	}
+	else
+	{
+		for (int32 Row = 0; Row < Height; ++Row)
+		{
+			FMemory::Memcpy(TexDst + Row * DestStride, FontTextureData.GetData() + Row * SrcStride, SrcStride);
+		}
+	}
 	RHICmdList.UnlockTexture2D(ImGuiFontTexture, 0, false);
 
+	//Bilinear, which AntiAliasedLinesUseTex relies on to fade baked lines out.
+	//Their UVs sit on texel boundaries, so clamp: wrapping would blend in the opposite edge when the lines are packed against the atlas border.
 	FSamplerStateInitializerRHI SamplerStateCreateInfo;
 	SamplerStateCreateInfo.Filter = SF_Trilinear;
-	SamplerStateCreateInfo.AddressU = AM_Wrap;
-	SamplerStateCreateInfo.AddressV = AM_Wrap;
-	SamplerStateCreateInfo.AddressW = AM_Wrap;
+	SamplerStateCreateInfo.AddressU = AM_Clamp;
+	SamplerStateCreateInfo.AddressV = AM_Clamp;
+	SamplerStateCreateInfo.AddressW = AM_Clamp;
 	SamplerStateCreateInfo.MipBias = 1.0f;
 	SamplerStateCreateInfo.MinMipLevel = 0;
 	SamplerStateCreateInfo.MaxMipLevel = 0;
@@ -255,189 +746,890 @@ void UnrealImGui::Render_GameThread(const FViewport* const Viewport)
 	IO.KeySuper = Viewport->KeyState(EKeys::LeftCommand) || Viewport->KeyState(EKeys::RightCommand);
 	
 	//FCS TODO: Nav Input (Gamepad)
+
+	//Debug primitives other threads queued since the last frame
+	UnrealImGui::FImGuiDebugDrawView DebugDrawView;
+	DebugDrawQueue.Drain(ImGui::GetBackgroundDrawList(), ImGui::GetForegroundDrawList(), GetDebugDrawView(DebugDrawView) ? &DebugDrawView : nullptr);
 	
 	ImGui::Render();
 	
 	const ImDrawData* ImGuiDrawData = ImGui::GetDrawData();
-	if (!ImGuiDrawData || ImGuiDrawData->TotalVtxCount == 0)
+	if (!ImGuiDrawData || (ImGuiDrawData->TotalVtxCount == 0 && PrimitiveBuffer.GetPrimitives().Num() == 0))
 	{
 		return;
 	}
 
-	//Create a Copy of most of ImGuiDrawData (stored in FUnrealImGuiDrawData, which owns its CmdLists) to be passed to the render thread
-	FUnrealImGuiDrawData UnrealImGuiDrawData;
-	
-	UnrealImGuiDrawData.CmdLists.Reserve(ImGuiDrawData->CmdListsCount);
-	for (int32 i = 0; i < ImGuiDrawData->CmdListsCount; ++i)
+	const ERHIFeatureLevel::Type FeatureLevel = World->FeatureLevel;
+	const bool bShaderClip = UseShaderClip(FeatureLevel);
+
+	//A frame identical to the last one we queued doesn't need a new snapshot, the render thread draws the one it kept (see LastDrawData)
+	const uint64 ContentHash = GReuseUnchangedFrames ? HashDrawData(*ImGuiDrawData, TextureRegistry, PrimitiveBuffer, GMultiTexture, bShaderClip) : 0;
+	const bool bUnchanged = ContentHash != 0 && ContentHash == LastQueuedContentHash;
+	LastQueuedContentHash = ContentHash;
+
+	//Snapshot ImGuiDrawData into a pooled FUnrealImGuiDrawData, which the render thread owns until it's done with it
+	FUnrealImGuiDrawData* UnrealImGuiDrawData = nullptr;
+	if (bUnchanged)
 	{
-		UnrealImGuiDrawData.CmdLists.Add(*ImGuiDrawData->CmdLists[i]);
+		INC_DWORD_STAT(STAT_ImGuiUnchangedFrames);
+	}
+	else
+	{
+		UnrealImGuiDrawData = DrawDataPool->Acquire();
+		UnrealImGuiDrawData->CopyFrom(*ImGuiDrawData, TextureRegistry, PrimitiveBuffer, GMultiTexture, bShaderClip);
+		UnrealImGuiDrawData->ContentHash = ContentHash;
 	}
-	UnrealImGuiDrawData.TotalIdxCount = ImGuiDrawData->TotalIdxCount;
-	UnrealImGuiDrawData.TotalVtxCount = ImGuiDrawData->TotalVtxCount;
-	UnrealImGuiDrawData.DisplayPos = ImGuiDrawData->DisplayPos;
-	UnrealImGuiDrawData.DisplaySize = ImGuiDrawData->DisplaySize;
-	UnrealImGuiDrawData.FramebufferScale = ImGuiDrawData->FramebufferScale;
 
-	const ERHIFeatureLevel::Type FeatureLevel = World->FeatureLevel;
+	//Glyphs rasterized while building this frame
+	TArray<FImGuiGlyphCache::FUpload> GlyphUploads;
+	GlyphCache.GatherUploads(GlyphUploads);
 	
 	ENQUEUE_RENDER_COMMAND(RenderImGuiCmd)(
-	    [UnrealImGuiDrawData, FeatureLevel, Viewport](FRHICommandListImmediate& RHICmdList)
+	    [UnrealImGuiDrawData, FeatureLevel, Viewport, GlyphUploads = MoveTemp(GlyphUploads)](FRHICommandListImmediate& RHICmdList) mutable
 		{
-	    	const FTexture2DRHIRef& RenderTargetTexture = Viewport->GetRenderTargetTexture();
-		    Render_RenderThread(RHICmdList, FeatureLevel, UnrealImGuiDrawData, RenderTargetTexture);
+	    	//Keep the newest snapshot around for unchanged frames, which don't send one
+	    	if (UnrealImGuiDrawData != nullptr)
+	    	{
+	    		if (LastDrawData != nullptr)
+	    		{
+	    			FImGuiDrawDataPool::Release(LastDrawData);
+	    		}
+	    		LastDrawData = UnrealImGuiDrawData;
+	    	}
+	    	else if (LastDrawData == nullptr)
+	    	{
+	    		return;
+	    	}
+
+	    	FRDGBuilder GraphBuilder(RHICmdList, RDG_EVENT_NAME("UnrealImGui"));
+
+	    	FRDGTextureRef FontAtlas = ImGuiFontTexture.IsValid() ? GraphBuilder.RegisterExternalTexture(CreateRenderTarget(ImGuiFontTexture, TEXT("ImGuiFontTexture"))) : nullptr;
+	    	AddFontUploadPass(GraphBuilder, FontAtlas, MoveTemp(GlyphUploads));
+
+	    	//The viewport's back buffer isn't owned by a graph, so hand it back ready for whoever draws to it next
+	    	FRDGTextureRef RenderTarget = GraphBuilder.RegisterExternalTexture(CreateRenderTarget(Viewport->GetRenderTargetTexture(), TEXT("ImGuiRenderTarget")));
+	    	GraphBuilder.SetTextureAccessFinal(RenderTarget, ERHIAccess::RTV);
+
+		    Render_RenderThread(GraphBuilder, FeatureLevel, *LastDrawData, RenderTarget, FontAtlas);
+	    	GraphBuilder.Execute();
 		}
 	);
 }
 
-void UnrealImGui::Render_RenderThread(FRHICommandListImmediate& RHICmdList, ERHIFeatureLevel::Type FeatureLevel, const FUnrealImGuiDrawData& ImGuiDrawData, const FTexture2DRHIRef& RenderTargetTexture)
+void UnrealImGui::FUnrealImGuiDrawData::CopyFrom(const ImDrawData& DrawData, const FImGuiTextureRegistry& InTextureRegistry, const FImGuiPrimitiveBuffer& InPrimitiveBuffer, bool bInMultiTexture, bool bInShaderClip)
 {
-	SCOPED_DRAW_EVENT(RHICmdList, ImGui)
-	
-	//Create/Resize Vertex Buffer
-	const int32 VertexCount = ImGuiDrawData.TotalVtxCount;
-	size_t VertexBufferSize = VertexCount * sizeof(ImDrawVert);
-	FRHIResourceCreateInfo VertexBufferCreateInfo(TEXT("ImGuiVertexBuffer"));
-	ImguiVertexBuffer = RHICreateVertexBuffer(VertexBufferSize, BUF_Dynamic, VertexBufferCreateInfo);
-	
-	//Create/Resize Index Buffer
-	const int32 IndexCount = ImGuiDrawData.TotalIdxCount;
-	size_t IndexBufferSize = IndexCount * sizeof(ImDrawIdx);
-	FRHIResourceCreateInfo IndexBufferCreateInfo(TEXT("ImGuiIndexBuffer"));
-	ImguiIndexBuffer = RHICreateIndexBuffer(sizeof(ImDrawIdx), IndexBufferSize, BUF_Dynamic, IndexBufferCreateInfo);
+	bMultiTexture = bInMultiTexture;
 
+	//Each command adds at most one clip rect, so that bounds how many the frame can need
+	int32 TotalCmdCount = 0;
+	for (int32 ListIndex = 0; ListIndex < DrawData.CmdListsCount; ++ListIndex)
 	{
-		ImDrawVert* VtxDst = static_cast<ImDrawVert*>(RHICmdList.LockBuffer(ImguiVertexBuffer, 0, VertexBufferSize, RLM_WriteOnly));
-		ImDrawIdx*  IdxDst = static_cast<ImDrawIdx*>(RHICmdList.LockBuffer(ImguiIndexBuffer, 0, IndexBufferSize, RLM_WriteOnly));
+		TotalCmdCount += DrawData.CmdLists[ListIndex]->CmdBuffer.Size;
+	}
+	bShaderClip = bInShaderClip && TotalCmdCount <= static_cast<int32>(MaxShaderClipRects);
+
+	//Set first, AddClipRect projects into the framebuffer with them
+	DisplayPos = DrawData.DisplayPos;
+	DisplaySize = DrawData.DisplaySize;
+	FramebufferScale = DrawData.FramebufferScale;
 
-		for (const auto& CmdList : ImGuiDrawData.CmdLists)
+	//Don't allow shrinking, so the arrays settle on the largest frame we've seen
+	VtxBuffer.SetNumUninitialized(DrawData.TotalVtxCount, false);
+	VtxAuxBuffer.SetNumUninitialized(bMultiTexture || bShaderClip ? DrawData.TotalVtxCount : 0, false);
+	Primitives.Reset();
+	Primitives.Append(InPrimitiveBuffer.GetPrimitives());
+	IdxBuffer.Reset(DrawData.TotalIdxCount);
+	CmdBuffer.Reset();
+	Textures.Reset();
+	TextureSets.Reset();
+	ClipRects.Reset();
+	NumCallbackDrawLists = 0;
+	bAnalyticAA = false;
+
+	//Texture 0 is always the font atlas
+	FUnrealImGuiTexture FontAtlas;
+	FontAtlas.bFontAtlas = true;
+	Textures.Add(FontAtlas);
+
+	ImDrawVert* VtxDst = VtxBuffer.GetData();
+	uint32 GlobalVtxOffset = 0;
+	const ImVec2 DisplayMax(DrawData.DisplayPos.x + DrawData.DisplaySize.x, DrawData.DisplayPos.y + DrawData.DisplaySize.y);
+
+	for (int32 ListIndex = 0; ListIndex < DrawData.CmdListsCount; ++ListIndex)
+	{
+		const ImDrawList* CmdList = DrawData.CmdLists[ListIndex];
+		FMemory::Memcpy(VtxDst + GlobalVtxOffset, CmdList->VtxBuffer.Data, CmdList->VtxBuffer.Size * sizeof(ImDrawVert));
+		bAnalyticAA |= (CmdList->Flags & ImDrawListFlags_AntiAliasedLinesAnalytic) != 0;
+		const ImDrawList* CallbackDrawList = nullptr;
+
+		for (const ImDrawCmd& Cmd : CmdList->CmdBuffer)
 		{
-			FMemory::Memcpy(VtxDst, CmdList.VtxBuffer.Data, CmdList.VtxBuffer.Size * sizeof(ImDrawVert));
-			FMemory::Memcpy(IdxDst, CmdList.IdxBuffer.Data, CmdList.IdxBuffer.Size * sizeof(ImDrawIdx));
-			
-			VtxDst += CmdList.VtxBuffer.Size;
-			IdxDst += CmdList.IdxBuffer.Size;
+			if (Cmd.UserCallback != nullptr)
+			{
+				//Callbacks have to run in order, so nothing can be merged across them
+				FlushPendingBatches(*CmdList, GlobalVtxOffset);
+
+				FUnrealImGuiDrawCmd& FlatCmd = CmdBuffer.AddZeroed_GetRef();
+				FlatCmd.ClipRect = Cmd.ClipRect;
+				FlatCmd.VtxOffset = Cmd.VtxOffset + GlobalVtxOffset;
+				FlatCmd.IdxOffset = IdxBuffer.Num();
+				FlatCmd.UserCallback = Cmd.UserCallback;
+				FlatCmd.UserCallbackData = Cmd.UserCallbackData;
+				if (Cmd.UserCallback == PrimitiveBatchCallback)
+				{
+					const FImGuiPrimitiveBuffer::FBatch& Batch = InPrimitiveBuffer.GetBatch(Cmd);
+					FlatCmd.VtxOffset = Batch.FirstPrimitive;
+					FlatCmd.ElemCount = Batch.NumPrimitives;
+				}
+				else if (Cmd.UserCallback != ImDrawCallback_ResetRenderState)
+				{
+					if (CallbackDrawList == nullptr)
+					{
+						CallbackDrawList = AddCallbackDrawList(*CmdList);
+					}
+					FlatCmd.CallbackDrawList = CallbackDrawList;
+					FlatCmd.CallbackCmd = &CallbackDrawList->CmdBuffer[static_cast<int32>(&Cmd - CmdList->CmdBuffer.Data)];
+				}
+				continue;
+			}
+
+			//Fully clipped (e.g. scrolled out of its window, or outside the display), no need to copy its indices
+			if (Cmd.ClipRect.z <= Cmd.ClipRect.x || Cmd.ClipRect.w <= Cmd.ClipRect.y
+				|| Cmd.ClipRect.x >= DisplayMax.x || Cmd.ClipRect.y >= DisplayMax.y || Cmd.ClipRect.z <= DrawData.DisplayPos.x || Cmd.ClipRect.w <= DrawData.DisplayPos.y)
+			{
+				INC_DWORD_STAT(STAT_ImGuiCulledCommands);
+				continue;
+			}
+
+			if (Cmd.ElemCount == 0)
+			{
+				continue;
+			}
+			//Unregistered IDs, or textures that were garbage collected or have no resource yet
+			FUnrealImGuiTexture Texture;
+			if (!InTextureRegistry.Resolve(Cmd.TextureId, Texture))
+			{
+				INC_DWORD_STAT(STAT_ImGuiUnresolvedTextureCommands);
+				continue;
+			}
+			const uint32 TextureIndex = AddTexture(Texture);
+
+			//Look for an earlier batch with the same state that we can move this command into.
+			//We can only move it back past batches whose clip rects don't overlap ours, as those can't draw over the same pixels.
+			//In shader clipping mode the batch's clip rect is the union of its commands', which keeps that test conservative.
+			constexpr int32 MaxLookBack = 16;
+			int32 MergeIndex = INDEX_NONE;
+			for (int32 BatchIndex = PendingBatches.Num() - 1; BatchIndex >= FMath::Max(0, PendingBatches.Num() - MaxLookBack); --BatchIndex)
+			{
+				const FUnrealImGuiDrawCmd& BatchCmd = PendingBatches[BatchIndex].Cmd;
+				const bool bSameClipRect = bShaderClip || (BatchCmd.ClipRect.x == Cmd.ClipRect.x && BatchCmd.ClipRect.y == Cmd.ClipRect.y
+					&& BatchCmd.ClipRect.z == Cmd.ClipRect.z && BatchCmd.ClipRect.w == Cmd.ClipRect.w);
+				const bool bCompatibleTexture = bMultiTexture ? PendingBatches[BatchIndex].TextureSet.CanAdd(TextureIndex) : BatchCmd.TextureIndex == TextureIndex;
+				if (bSameClipRect && bCompatibleTexture && BatchCmd.VtxOffset == Cmd.VtxOffset)
+				{
+					MergeIndex = BatchIndex;
+					break;
+				}
+
+				const bool bOverlaps = BatchCmd.ClipRect.x < Cmd.ClipRect.z && Cmd.ClipRect.x < BatchCmd.ClipRect.z
+					&& BatchCmd.ClipRect.y < Cmd.ClipRect.w && Cmd.ClipRect.y < BatchCmd.ClipRect.w;
+				if (bOverlaps)
+				{
+					break;
+				}
+			}
+
+			const uint32 ClipRectIndex = bShaderClip ? AddClipRect(Cmd.ClipRect) : 0;
+			const int32 RangeIndex = PendingRanges.Add({ Cmd.IdxOffset, Cmd.ElemCount, TextureIndex, ClipRectIndex, INDEX_NONE });
+			if (MergeIndex != INDEX_NONE)
+			{
+				FPendingBatch& Batch = PendingBatches[MergeIndex];
+				PendingRanges[Batch.LastRange].NextRange = RangeIndex;
+				Batch.LastRange = RangeIndex;
+				Batch.Cmd.ElemCount += Cmd.ElemCount;
+				Batch.TextureSet.Add(TextureIndex);
+				if (bShaderClip)
+				{
+					ImVec4& BatchClipRect = Batch.Cmd.ClipRect;
+					BatchClipRect = ImVec4(FMath::Min(BatchClipRect.x, Cmd.ClipRect.x), FMath::Min(BatchClipRect.y, Cmd.ClipRect.y),
+						FMath::Max(BatchClipRect.z, Cmd.ClipRect.z), FMath::Max(BatchClipRect.w, Cmd.ClipRect.w));
+				}
+				INC_DWORD_STAT(STAT_ImGuiMergedCommands);
+			}
+			else
+			{
+				FPendingBatch& Batch = PendingBatches.AddZeroed_GetRef();
+				Batch.Cmd.ClipRect = Cmd.ClipRect;
+				Batch.Cmd.TextureIndex = TextureIndex;
+				Batch.Cmd.VtxOffset = Cmd.VtxOffset;
+				Batch.Cmd.ElemCount = Cmd.ElemCount;
+				Batch.TextureSet.Add(0); //Font atlas always lives in slot 0
+				Batch.TextureSet.Add(TextureIndex);
+				Batch.FirstRange = RangeIndex;
+				Batch.LastRange = RangeIndex;
+			}
 		}
-		
-		RHICmdList.UnlockBuffer(ImguiVertexBuffer);
-		RHICmdList.UnlockBuffer(ImguiIndexBuffer);
+
+		FlushPendingBatches(*CmdList, GlobalVtxOffset);
+		GlobalVtxOffset += CmdList->VtxBuffer.Size;
 	}
-	
+}
+
+uint32 UnrealImGui::FUnrealImGuiDrawData::AddTexture(const FUnrealImGuiTexture& Texture)
+{
+	//Frames only reference a handful of textures, so a linear search is fine
+	const int32 ExistingIndex = Textures.IndexOfByKey(Texture);
+	return ExistingIndex != INDEX_NONE ? ExistingIndex : Textures.Add(Texture);
+}
+
+uint32 UnrealImGui::FUnrealImGuiDrawData::AddClipRect(const ImVec4& ClipRect)
+{
+	//Project into framebuffer pixels the same way GetScissorRect does, so the pixel shader keeps exactly the pixels the scissor test would
+	const FVector4f PixelRect(
+		FMath::TruncToFloat((ClipRect.x - DisplayPos.x) * FramebufferScale.x),
+		FMath::TruncToFloat((ClipRect.y - DisplayPos.y) * FramebufferScale.y),
+		FMath::TruncToFloat((ClipRect.z - DisplayPos.x) * FramebufferScale.x),
+		FMath::TruncToFloat((ClipRect.w - DisplayPos.y) * FramebufferScale.y));
+
+	//Consecutive commands mostly share their clip rect
+	if (ClipRects.Num() > 0 && ClipRects.Last() == PixelRect)
+	{
+		return ClipRects.Num() - 1;
+	}
+	check(ClipRects.Num() < static_cast<int32>(MaxShaderClipRects));
+	return ClipRects.Add(PixelRect);
+}
+
+void UnrealImGui::FUnrealImGuiDrawData::FlushPendingBatches(const ImDrawList& CmdList, uint32 ListVtxOffset)
+{
+	//32-bit indices can address the whole vertex buffer, so bake the vertex offset into them.
+	//Every command then shares VtxOffset 0 and the render thread can fold draws across ImDrawLists.
+	constexpr bool bRebaseIndices = sizeof(ImDrawIdx) == sizeof(uint32);
+
+	//Write out each batch's indices contiguously so it can be drawn with a single call
+	for (const FPendingBatch& Batch : PendingBatches)
+	{
+		FUnrealImGuiDrawCmd& FlatCmd = CmdBuffer.Add_GetRef(Batch.Cmd);
+		const uint32 BaseVertex = FlatCmd.VtxOffset + ListVtxOffset;
+		FlatCmd.VtxOffset = bRebaseIndices ? 0 : BaseVertex;
+		FlatCmd.IdxOffset = IdxBuffer.Num();
+		if (bMultiTexture)
+		{
+			FlatCmd.TextureIndex = TextureSets.Add(Batch.TextureSet);
+		}
+
+		for (int32 RangeIndex = Batch.FirstRange; RangeIndex != INDEX_NONE; RangeIndex = PendingRanges[RangeIndex].NextRange)
+		{
+			const FIndexRange& Range = PendingRanges[RangeIndex];
+			const ImDrawIdx* RangeIndices = CmdList.IdxBuffer.Data + Range.IdxOffset;
+			if (bRebaseIndices)
+			{
+				const int32 FirstIndex = IdxBuffer.AddUninitialized(Range.ElemCount);
+				ImDrawIdx* IdxDst = IdxBuffer.GetData() + FirstIndex;
+				for (uint32 i = 0; i < Range.ElemCount; ++i)
+				{
+					IdxDst[i] = static_cast<ImDrawIdx>(RangeIndices[i] + BaseVertex);
+				}
+			}
+			else
+			{
+				IdxBuffer.Append(RangeIndices, Range.ElemCount);
+			}
+
+			//Tag every vertex this range uses with the slot its texture is bound to and its clip rect
+			if (bMultiTexture || bShaderClip)
+			{
+				FUnrealImGuiVertexAux Aux;
+				Aux.TextureSlot = bMultiTexture ? static_cast<uint8>(Batch.TextureSet.FindSlot(Range.TextureIndex)) : 0;
+				Aux.Padding = 0;
+				Aux.ClipRectIndex = static_cast<uint16>(Range.ClipRectIndex);
+				FUnrealImGuiVertexAux* VtxAuxDst = VtxAuxBuffer.GetData() + BaseVertex;
+				for (uint32 i = 0; i < Range.ElemCount; ++i)
+				{
+					VtxAuxDst[RangeIndices[i]] = Aux;
+				}
+			}
+		}
+	}
+
+	PendingBatches.Reset();
+	PendingRanges.Reset();
+}
+
+const ImDrawList* UnrealImGui::FUnrealImGuiDrawData::AddCallbackDrawList(const ImDrawList& CmdList)
+{
+	if (NumCallbackDrawLists == CallbackDrawLists.Num())
+	{
+		CallbackDrawLists.Add(MakeUnique<ImDrawList>(nullptr));
+	}
+	ImDrawList& Copy = *CallbackDrawLists[NumCallbackDrawLists++];
+
+	//ImVector's assignment frees its buffer first, resize keeps it
+	auto CopyVector = [](auto& Dst, const auto& Src)
+	{
+		Dst.resize(Src.Size);
+		FMemory::Memcpy(Dst.Data, Src.Data, Src.size_in_bytes());
+	};
+	CopyVector(Copy.CmdBuffer, CmdList.CmdBuffer);
+	CopyVector(Copy.IdxBuffer, CmdList.IdxBuffer);
+	CopyVector(Copy.VtxBuffer, CmdList.VtxBuffer);
+	Copy.Flags = CmdList.Flags;
+	return &Copy;
+}
+
+ImTextureID UnrealImGui::RegisterTexture(UTexture* Texture, bool bIgnoreAlpha)
+{
+	return TextureRegistry.Register(Texture, bIgnoreAlpha);
+}
+
+ImTextureID UnrealImGui::RegisterTexture(FRHITexture* Texture, bool bIgnoreAlpha)
+{
+	return TextureRegistry.Register(Texture, bIgnoreAlpha);
+}
+
+void UnrealImGui::UnregisterTexture(ImTextureID TextureId)
+{
+	TextureRegistry.Unregister(TextureId);
+}
+
+void UnrealImGui::AddLine(ImDrawList* DrawList, const ImVec2& P0, const ImVec2& P1, ImU32 Col, float Thickness)
+{
+	if (!UseGpuPrimitives())
+	{
+		DrawList->AddLine(P0, P1, Col, Thickness);
+		return;
+	}
+	if ((Col & IM_COL32_A_MASK) == 0)
+	{
+		return;
+	}
+
+	//Same half pixel offset ImDrawList::AddLine applies
+	const ImVec2 Start(P0.x + 0.5f, P0.y + 0.5f);
+	const ImVec2 End(P1.x + 0.5f, P1.y + 0.5f);
+	PrimitiveBuffer.Add(DrawList, { Start, End, 0.0f, Thickness, Col, EImGuiPrimitiveType::Line });
+}
+
+void UnrealImGui::AddPolyline(ImDrawList* DrawList, const ImVec2* Points, int32 NumPoints, ImU32 Col, bool bClosed, float Thickness)
+{
+	if (!UseGpuPrimitives())
+	{
+		DrawList->AddPolyline(Points, NumPoints, Col, bClosed, Thickness);
+		return;
+	}
+	if ((Col & IM_COL32_A_MASK) == 0 || NumPoints < 2)
+	{
+		return;
+	}
+
+	const int32 NumSegments = bClosed ? NumPoints : NumPoints - 1;
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		const ImVec2& P0 = Points[SegmentIndex];
+		const ImVec2& P1 = Points[(SegmentIndex + 1) % NumPoints];
+		PrimitiveBuffer.Add(DrawList, { P0, P1, 0.0f, Thickness, Col, EImGuiPrimitiveType::Line });
+	}
+}
+
+void UnrealImGui::AddCircle(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Col, float Thickness)
+{
+	if (!UseGpuPrimitives())
+	{
+		DrawList->AddCircle(Center, Radius, Col, 0, Thickness);
+		return;
+	}
+	if ((Col & IM_COL32_A_MASK) == 0 || Radius <= 0.0f)
+	{
+		return;
+	}
+
+	//ImDrawList::AddCircle strokes half a pixel inside Radius
+	PrimitiveBuffer.Add(DrawList, { Center, Center, Radius - 0.5f, Thickness, Col, EImGuiPrimitiveType::Circle });
+}
+
+void UnrealImGui::AddCircleFilled(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Col)
+{
+	if (!UseGpuPrimitives())
+	{
+		DrawList->AddCircleFilled(Center, Radius, Col, 0);
+		return;
+	}
+	if ((Col & IM_COL32_A_MASK) == 0 || Radius <= 0.0f)
+	{
+		return;
+	}
+
+	PrimitiveBuffer.Add(DrawList, { Center, Center, Radius, 0.0f, Col, EImGuiPrimitiveType::CircleFilled });
+}
+
+static ImU32 ToImU32(FColor Color)
+{
+	return IM_COL32(Color.R, Color.G, Color.B, Color.A);
+}
+
+void UnrealImGui::DebugDrawLine(const FVector2D& P0, const FVector2D& P1, FColor Color, float Thickness, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ FVector(P0, 0.0), FVector(P1, 0.0), 0.0f, Thickness, ToImU32(Color), EImGuiDebugDrawType::Line, Layer });
+}
+
+void UnrealImGui::DebugDrawRect(const FVector2D& Min, const FVector2D& Max, FColor Color, float Thickness, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ FVector(Min, 0.0), FVector(Max, 0.0), 0.0f, Thickness, ToImU32(Color), EImGuiDebugDrawType::Rect, Layer });
+}
+
+void UnrealImGui::DebugDrawRectFilled(const FVector2D& Min, const FVector2D& Max, FColor Color, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ FVector(Min, 0.0), FVector(Max, 0.0), 0.0f, 0.0f, ToImU32(Color), EImGuiDebugDrawType::RectFilled, Layer });
+}
+
+void UnrealImGui::DebugDrawCircle(const FVector2D& Center, float Radius, FColor Color, float Thickness, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ FVector(Center, 0.0), FVector::ZeroVector, Radius, Thickness, ToImU32(Color), EImGuiDebugDrawType::Circle, Layer });
+}
+
+void UnrealImGui::DebugDrawCircleFilled(const FVector2D& Center, float Radius, FColor Color, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ FVector(Center, 0.0), FVector::ZeroVector, Radius, 0.0f, ToImU32(Color), EImGuiDebugDrawType::CircleFilled, Layer });
+}
+
+void UnrealImGui::DebugDrawText(const FVector2D& Position, FStringView Text, FColor Color, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ FVector(Position, 0.0), FVector::ZeroVector, 0.0f, 0.0f, ToImU32(Color), EImGuiDebugDrawType::Text, Layer }, Text);
+}
+
+void UnrealImGui::DebugDrawWorldPoint(const FVector& Location, FColor Color, float Size, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ Location, FVector::ZeroVector, Size, 0.0f, ToImU32(Color), EImGuiDebugDrawType::WorldPoint, Layer });
+}
+
+void UnrealImGui::DebugDrawWorldLine(const FVector& Start, const FVector& End, FColor Color, float Thickness, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ Start, End, 0.0f, Thickness, ToImU32(Color), EImGuiDebugDrawType::WorldLine, Layer });
+}
+
+void UnrealImGui::DebugDrawWorldText(const FVector& Location, FStringView Text, FColor Color, EImGuiDebugDrawLayer Layer)
+{
+	DebugDrawQueue.Add({ Location, FVector::ZeroVector, 0.0f, 0.0f, ToImU32(Color), EImGuiDebugDrawType::WorldText, Layer }, Text);
+}
+
+//Render Thread: Records draws for commands [FirstCmdIndex, EndCmdIndex) of ImGuiDrawData. Binds all its own state, so ranges can be recorded independently.
+//AlphaBlendMode replaces EImGuiBlendMode::AlphaBlend, to draw into the overlay.
+static void RecordDraws_RenderThread(FRHICommandList& RHICmdList, ERHIFeatureLevel::Type FeatureLevel, const UnrealImGui::FUnrealImGuiDrawData& ImGuiDrawData, FRHITexture* RenderTargetTexture,
+	const TUniformBufferRef<FImGuiUniformParameters>& UniformBuffer, const UnrealImGui::FImGuiBufferRing::FSlotRef& GeometryBuffers, UnrealImGui::EImGuiBlendMode AlphaBlendMode, FRHIShaderResourceView* ClipRectsSRV, int32 FirstCmdIndex, int32 EndCmdIndex)
+{
+	using namespace UnrealImGui;
+
+	FRHIBuffer* VertexBuffer = GeometryBuffers.VertexBuffer;
+	FRHIBuffer* AuxVertexBuffer = GeometryBuffers.AuxVertexBuffer;
+	FRHIBuffer* IndexBuffer = GeometryBuffers.IndexBuffer;
+	FRHIBuffer* PrimitiveInstanceBuffer = GeometryBuffers.PrimitiveBuffer;
+
 	// Get the collection of Global Shaders
 	auto ShaderMap = GetGlobalShaderMap(FeatureLevel);
 	// Get the actual shader instances off the ShaderMap
-	TShaderMapRef<FImGuiVS> MyVS(ShaderMap);
-	TShaderMapRef<FImGuiPS> MyPS(ShaderMap);
-
-	// Declare a pipeline state object that holds all the rendering state
-	FGraphicsPipelineStateInitializer PSOInitializer;
-	PSOInitializer.RenderTargetsEnabled = 1;
-	PSOInitializer.NumSamples = RenderTargetTexture->GetNumSamples();
-	PSOInitializer.RenderTargetFormats[0] = RenderTargetTexture->GetFormat();
-	PSOInitializer.RenderTargetFlags[0] = RenderTargetTexture->GetFlags();
-
-	//FCS NOTE: Is there a Debug Render target that draws over everything (Debug/UI)?
-	FRHIRenderPassInfo RenderPassInfo(RenderTargetTexture, ERenderTargetActions::Load_Store);
-	RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("UnrealImGui"));
-	{
-		PSOInitializer.PrimitiveType = PT_TriangleList;
-
-		FVertexDeclarationElementList Elements;
-		uint32 Stride = sizeof(ImDrawVert);
-		Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, pos), VET_Float2, 0, Stride));
-		Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, uv), VET_Float2, 1, Stride));
-		Elements.Add(FVertexElement(0, STRUCT_OFFSET(ImDrawVert, col), VET_UByte4N, 2, Stride));
-	
-		PSOInitializer.BoundShaderState.VertexDeclarationRHI = PipelineStateCache::GetOrCreateVertexDeclaration(Elements);
-		PSOInitializer.BoundShaderState.VertexShaderRHI = MyVS.GetVertexShader();
-		PSOInitializer.BoundShaderState.PixelShaderRHI = MyPS.GetPixelShader();
-		PSOInitializer.RasterizerState = TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
-		PSOInitializer.BlendState = TStaticBlendState<
-            /*EColorWriteMask RT0ColorWriteMask = */ CW_RGBA,
-            /*EBlendOperation RT0ColorBlendOp = */ BO_Add,
-            /*EBlendFactor    RT0ColorSrcBlend = */ BF_SourceAlpha,
-            /*EBlendFactor    RT0ColorDestBlend = */ BF_InverseSourceAlpha,
-            /*EBlendOperation RT0AlphaBlendOp = */ BO_Add,
-            /*EBlendFactor    RT0AlphaSrcBlend = */ BF_InverseSourceAlpha,
-            /*EBlendFactor    RT0AlphaDestBlend = */ BF_Zero
-        >::GetRHI();
-		PSOInitializer.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
-
-		//FCS TODO: FIXME: D3D12 Crashing on PSO Creation. D3D11 and Vulkan seemingly fine
-		SetGraphicsPipelineState(RHICmdList, PSOInitializer, 0);
-
-		// Setup Our Parameters. This has to happen after SetGraphicsPipelineState
-		{
-			//Setup projection matrix	
-			const float L = ImGuiDrawData.DisplayPos.x;
-			const float R = ImGuiDrawData.DisplayPos.x + ImGuiDrawData.DisplaySize.x;
-			const float T = ImGuiDrawData.DisplayPos.y;
-			const float B = ImGuiDrawData.DisplayPos.y + ImGuiDrawData.DisplaySize.y;
-
-			const FMatrix44f OrthographicProjection(
-                FPlane4f(2.0f/(R-L),   0.0f,           0.0f,       0.0f),
-				FPlane4f(0.0f,         2.0f/(T-B),     0.0f,       0.0f),
-				FPlane4f(0.0f,         0.0f,           0.5f,       0.0f),
-				FPlane4f((R+L)/(L-R),  (T+B)/(B-T),    0.5f,       1.0f)
-            );
-
-			MyVS->SetProjectionMatrix(RHICmdList, OrthographicProjection.GetTransposed(), FeatureLevel);
-
-			//Setup Font Texture
-			MyPS->SetFontTexture(RHICmdList, ImGuiFontTexture, ImGuiFontSampler, FeatureLevel);
+	const bool bMultiTexture = ImGuiDrawData.bMultiTexture;
+	const bool bShaderClip = ImGuiDrawData.bShaderClip;
+	const bool bPackedVertices = GeometryBuffers.bPackedVertices;
+	FImGuiVS::FPermutationDomain VSPermutationVector;
+	VSPermutationVector.Set<FImGuiMultiTextureDim>(bMultiTexture);
+	VSPermutationVector.Set<FImGuiShaderClipDim>(bShaderClip);
+	VSPermutationVector.Set<FImGuiPackedVertexDim>(bPackedVertices);
+	FImGuiPS::FPermutationDomain PSPermutationVector;
+	PSPermutationVector.Set<FImGuiMultiTextureDim>(bMultiTexture);
+	PSPermutationVector.Set<FImGuiShaderClipDim>(bShaderClip);
+	TShaderMapRef<FImGuiVS> VertexShader(ShaderMap, VSPermutationVector);
+	TShaderRef<FImGuiPS> PixelShader;
+
+	FImGuiVS::FParameters VSParameters;
+	VSParameters.ImGuiUniforms = UniformBuffer;
+	VSParameters.ImGuiClipRects = ClipRectsSRV;
+	FImGuiPS::FParameters PSParameters = {};
+	PSParameters.ImGuiUniforms = UniformBuffer;
+
+	TShaderMapRef<FImGuiPrimitiveVS> PrimitiveVertexShader(ShaderMap);
+	FImGuiPrimitiveVS::FParameters PrimitiveVSParameters;
+	PrimitiveVSParameters.ImGuiUniforms = UniformBuffer;
+
+	//Coverage and distance field atlases need their own pixel shader permutation wherever the font is sampled (always slot 0 in multi-texture mode)
+	const EImGuiTextureKind FontTextureKind = ImGuiFontTexture.IsValid() ? ImGuiFontTextureKind : EImGuiTextureKind::Color;
+
+	FRHISamplerState* ImageSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+	ImVec2 ClipOff = ImGuiDrawData.DisplayPos;         // (0,0) unless using multi-viewports
+	ImVec2 ClipScale = ImGuiDrawData.FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+	//Only touch pipeline state and texture bindings when they differ from the previous draw
+	bool bPipelineBound = false;
+	EImGuiBlendMode BoundBlendMode = EImGuiBlendMode::AlphaBlend;
+	EImGuiTextureKind BoundTextureKind = EImGuiTextureKind::Color;
+	bool bBoundAnalyticAA = false;
+	uint32 BoundTextureIndex = MAX_uint32;
+
+	const FIntPoint RenderTargetSize = RenderTargetTexture->GetSizeXY();
+	for (int32 CmdIndex = FirstCmdIndex; CmdIndex < EndCmdIndex; ++CmdIndex)
+	{
+		const FUnrealImGuiDrawCmd& Cmd = ImGuiDrawData.CmdBuffer[CmdIndex];
+		if (Cmd.UserCallback == PrimitiveBatchCallback)
+		{
+			//One instance per primitive, expanded to two triangles by the vertex shader
+			FIntRect ScissorRect;
+			if (Cmd.ElemCount == 0 || !GetScissorRect(Cmd, ClipOff, ClipScale, RenderTargetSize, ScissorRect))
+			{
+				INC_DWORD_STAT(STAT_ImGuiCulledCommands);
+				continue;
+			}
+
+			const FImGuiPipelineKey PipelineKey(FeatureLevel, RenderTargetTexture, AlphaBlendMode, EImGuiTextureKind::Color, false, true);
+			SetGraphicsPipelineState(RHICmdList, GetPipelineState(PipelineKey), 0);
+			SetShaderParameters(RHICmdList, PrimitiveVertexShader, PrimitiveVertexShader.GetVertexShader(), PrimitiveVSParameters);
+			RHICmdList.SetStreamSource(0, PrimitiveInstanceBuffer, Cmd.VtxOffset * sizeof(FUnrealImGuiPrimitive));
+			RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y, ScissorRect.Max.X, ScissorRect.Max.Y);
+			RHICmdList.DrawPrimitive(0, 2, Cmd.ElemCount);
+			INC_DWORD_STAT(STAT_ImGuiDrawCalls);
+			INC_DWORD_STAT_BY(STAT_ImGuiGpuPrimitives, Cmd.ElemCount);
+
+			//The next regular draw has to bind its pipeline, streams and textures again
+			bPipelineBound = false;
+			BoundTextureIndex = MAX_uint32;
+			continue;
+		}
+		if (Cmd.UserCallback != nullptr)
+		{
+			//We don't change any state ImGui could ask us to reset. Other callbacks get the copy of their draw list CopyFrom made.
+			if (Cmd.UserCallback != ImDrawCallback_ResetRenderState)
+			{
+				check(IsInRenderingThread() && Cmd.CallbackDrawList != nullptr && Cmd.CallbackCmd != nullptr);
+				Cmd.UserCallback(Cmd.CallbackDrawList, Cmd.CallbackCmd);
+			}
+			continue;
 		}
 
-		//Cmd Bind Vertex Buffer
-		RHICmdList.SetStreamSource(0, ImguiVertexBuffer, 0);
-	
-		int GlobalVtxOffset = 0;
-		int GlobalIdxOffset = 0;
-		ImVec2 ClipOff = ImGuiDrawData.DisplayPos;         // (0,0) unless using multi-viewports
-		ImVec2 ClipScale = ImGuiDrawData.FramebufferScale; // (1,1) unless using retina display which are often (2,2)
-	
-		for (const auto& CmdList : ImGuiDrawData.CmdLists)
+		//Project the clip rect into framebuffer space, clamped to the render target. Nothing to draw if that leaves it empty.
+		FIntRect ScissorRect;
+		if (!GetScissorRect(Cmd, ClipOff, ClipScale, RenderTargetSize, ScissorRect))
 		{
-			for (const auto& Cmd : CmdList.CmdBuffer)
+			INC_DWORD_STAT(STAT_ImGuiCulledCommands);
+			continue;
+		}
+
+		//Fold the following commands into this draw while they share its state and their indices directly follow ours.
+		//In shader clipping mode the scissor isn't part of that state, each vertex carries its own clip rect.
+		uint32 ElemCount = Cmd.ElemCount;
+		while (CmdIndex + 1 < EndCmdIndex)
+		{
+			const FUnrealImGuiDrawCmd& NextCmd = ImGuiDrawData.CmdBuffer[CmdIndex + 1];
+			FIntRect NextScissorRect;
+			if (NextCmd.UserCallback != nullptr || NextCmd.TextureIndex != Cmd.TextureIndex || NextCmd.VtxOffset != Cmd.VtxOffset
+				|| NextCmd.IdxOffset != Cmd.IdxOffset + ElemCount
+				|| (!bShaderClip && (!GetScissorRect(NextCmd, ClipOff, ClipScale, RenderTargetSize, NextScissorRect) || NextScissorRect != ScissorRect)))
+			{
+				break;
+			}
+			ElemCount += NextCmd.ElemCount;
+			++CmdIndex;
+			INC_DWORD_STAT(STAT_ImGuiMergedCommands);
+		}
+
+		if (Cmd.TextureIndex != BoundTextureIndex)
+		{
+			//Regular mode binds a single texture, which may need an opaque pipeline.
+			//Multi-texture mode binds a whole set and handles opaque textures in the shader, so it never switches pipelines.
+			EImGuiBlendMode BlendMode = AlphaBlendMode;
+			EImGuiTextureKind TextureKind = bMultiTexture ? FontTextureKind : EImGuiTextureKind::Color;
+			FRHITexture* TextureRHI = nullptr;
+			FRHITexture* SetTexturesRHI[MaxBoundTextures];
+			uint32 OpaqueSlotMask = 0;
+			bool bFontAtlas = false;
+
+			if (bMultiTexture)
 			{
-				if (Cmd.UserCallback != nullptr)
+				const FUnrealImGuiTextureSet& TextureSet = ImGuiDrawData.TextureSets[Cmd.TextureIndex];
+				for (uint32 Slot = 0; Slot < MaxBoundTextures; ++Slot)
 				{
-					Cmd.UserCallback(&CmdList, &Cmd);
+					FRHITexture* SlotTextureRHI = nullptr;
+					if (Slot < TextureSet.NumTextures)
+					{
+						const FUnrealImGuiTexture& Texture = ImGuiDrawData.Textures[TextureSet.TextureIndices[Slot]];
+						SlotTextureRHI = ResolveTextureRHI(Texture);
+						OpaqueSlotMask |= Texture.bIgnoreAlpha ? (1u << Slot) : 0u;
+					}
+					SetTexturesRHI[Slot] = SlotTextureRHI != nullptr ? SlotTextureRHI : GBlackTexture->TextureRHI.GetReference();
 				}
-				else
+			}
+			else
+			{
+				const FUnrealImGuiTexture& Texture = ImGuiDrawData.Textures[Cmd.TextureIndex];
+				TextureRHI = ResolveTextureRHI(Texture);
+
+				//Texture hasn't been created by its owner yet
+				if (TextureRHI == nullptr)
 				{
-					// Project scissor/clipping rectangles into framebuffer space
-					ImVec4 ClipRect;
-					ClipRect.x = (Cmd.ClipRect.x - ClipOff.x) * ClipScale.x;
-					ClipRect.y = (Cmd.ClipRect.y - ClipOff.y) * ClipScale.y;
-					ClipRect.z = (Cmd.ClipRect.z - ClipOff.x) * ClipScale.x;
-					ClipRect.w = (Cmd.ClipRect.w - ClipOff.y) * ClipScale.y;
-
-					if (ClipRect.x < ImGuiDrawData.DisplaySize.x && ClipRect.y < ImGuiDrawData.DisplaySize.y && ClipRect.z >= 0.0f && ClipRect.w >= 0.0f)
-					{
-						// Negative offsets are illegal for vkCmdSetScissor
-						if (ClipRect.x < 0.0f) { ClipRect.x = 0.0f; }
-						if (ClipRect.y < 0.0f) { ClipRect.y = 0.0f; }
+					continue;
+				}
+				BlendMode = Texture.bIgnoreAlpha ? EImGuiBlendMode::Opaque : AlphaBlendMode;
+				TextureKind = Texture.bFontAtlas ? FontTextureKind : EImGuiTextureKind::Color;
+				bFontAtlas = Texture.bFontAtlas;
+			}
 
-						// // Apply scissor/clipping rectangle
-						RHICmdList.SetScissorRect(true, Cmd.ClipRect.x - ClipOff.x, Cmd.ClipRect.y - ClipOff.y, Cmd.ClipRect.z - ClipOff.x, Cmd.ClipRect.w - ClipOff.y);
+			//Analytic strokes use the font atlas' white pixel, so images never need the coverage test (multi-texture mode checks the slot in the shader)
+			const bool bAnalyticAA = ImGuiDrawData.bAnalyticAA && (bMultiTexture || bFontAtlas);
 
-						uint32 NumVertices = Cmd.ElemCount;
-						uint32 NumPrimitives = Cmd.ElemCount / 3;
-						RHICmdList.DrawIndexedPrimitive(ImguiIndexBuffer, Cmd.VtxOffset + GlobalVtxOffset, 0, NumVertices, Cmd.IdxOffset + GlobalIdxOffset, NumPrimitives, 1);
-					}
+			if (!bPipelineBound || BlendMode != BoundBlendMode || TextureKind != BoundTextureKind || bAnalyticAA != bBoundAnalyticAA)
+			{
+				//FCS TODO: FIXME: D3D12 Crashing on PSO Creation. D3D11 and Vulkan seemingly fine
+				const FImGuiPipelineKey PipelineKey(FeatureLevel, RenderTargetTexture, BlendMode, TextureKind, bMultiTexture, false, bShaderClip, bPackedVertices, bAnalyticAA);
+				SetGraphicsPipelineState(RHICmdList, GetPipelineState(PipelineKey), 0);
+
+				// Setup Our Parameters. This has to happen after SetGraphicsPipelineState
+				SetShaderParameters(RHICmdList, VertexShader, VertexShader.GetVertexShader(), VSParameters);
+
+				//Cmd Bind Vertex Buffer
+				RHICmdList.SetStreamSource(0, VertexBuffer, 0);
+				if (bMultiTexture || bShaderClip)
+				{
+					RHICmdList.SetStreamSource(1, AuxVertexBuffer, 0);
+				}
+
+				//The pixel shader clips, and GPU primitives may have left a scissor rect behind
+				if (bShaderClip)
+				{
+					RHICmdList.SetScissorRect(false, 0, 0, 0, 0);
 				}
+
+				bPipelineBound = true;
+				BoundBlendMode = BlendMode;
+				BoundTextureKind = TextureKind;
+				bBoundAnalyticAA = bAnalyticAA;
+				PSPermutationVector.Set<FImGuiAlpha8FontDim>(IsAlpha8Font(TextureKind));
+				PSPermutationVector.Set<FImGuiSdfFontDim>(IsSdfFont(TextureKind));
+				PSPermutationVector.Set<FImGuiAnalyticAADim>(bAnalyticAA);
+				PixelShader = TShaderMapRef<FImGuiPS>(ShaderMap, PSPermutationVector);
+			}
+
+			//Everything else lives in the frame's uniform buffer, so a texture switch only changes the texture bindings
+			if (bMultiTexture)
+			{
+				static_assert(MaxBoundTextures == 8, "Update the texture slot parameters");
+				PSParameters.ImGuiTexture = SetTexturesRHI[0];
+				PSParameters.ImGuiTexture1 = SetTexturesRHI[1];
+				PSParameters.ImGuiTexture2 = SetTexturesRHI[2];
+				PSParameters.ImGuiTexture3 = SetTexturesRHI[3];
+				PSParameters.ImGuiTexture4 = SetTexturesRHI[4];
+				PSParameters.ImGuiTexture5 = SetTexturesRHI[5];
+				PSParameters.ImGuiTexture6 = SetTexturesRHI[6];
+				PSParameters.ImGuiTexture7 = SetTexturesRHI[7];
+				PSParameters.ImGuiSampler = ImGuiFontSampler;
+				PSParameters.ImGuiOpaqueSlotMask = OpaqueSlotMask;
+			}
+			else
+			{
+				PSParameters.ImGuiTexture = TextureRHI;
+				PSParameters.ImGuiSampler = bFontAtlas ? ImGuiFontSampler.GetReference() : ImageSampler;
 			}
-			GlobalIdxOffset += CmdList.IdxBuffer.Size;
-			GlobalVtxOffset += CmdList.VtxBuffer.Size;
+			SetShaderParameters(RHICmdList, PixelShader, PixelShader.GetPixelShader(), PSParameters);
+			BoundTextureIndex = Cmd.TextureIndex;
+			INC_DWORD_STAT(STAT_ImGuiTextureBinds);
 		}
+
+		if (!bShaderClip)
+		{
+			RHICmdList.SetScissorRect(true, ScissorRect.Min.X, ScissorRect.Min.Y, ScissorRect.Max.X, ScissorRect.Max.Y);
+		}
+
+		uint32 NumVertices = ElemCount;
+		uint32 NumPrimitives = ElemCount / 3;
+		RHICmdList.DrawIndexedPrimitive(IndexBuffer, Cmd.VtxOffset, 0, NumVertices, Cmd.IdxOffset, NumPrimitives, 1);
+		INC_DWORD_STAT(STAT_ImGuiDrawCalls);
 	}
-	RHICmdList.EndRenderPass();
+}
+
+void UnrealImGui::Render_RenderThread(FRDGBuilder& GraphBuilder, ERHIFeatureLevel::Type FeatureLevel, const FUnrealImGuiDrawData& ImGuiDrawData, FRDGTextureRef RenderTarget, FRDGTextureRef FontAtlas)
+{
+	RDG_EVENT_SCOPE(GraphBuilder, "ImGui");
+
+	//Nothing survived culling, so don't add a pass at all
+	if (ImGuiDrawData.CmdBuffer.Num() == 0)
+	{
+		return;
+	}
+
+	//Frames that stop changing are drawn once into the overlay, then only composited
+	FRDGTextureRef Overlay = nullptr;
+	if (UseOverlayCache() && ImGuiDrawData.ContentHash != 0 && FImGuiOverlayCache::CanCache(ImGuiDrawData))
+	{
+		bool bOverlayUpToDate = false;
+		Overlay = ImGuiOverlayCache.Register(GraphBuilder, RenderTarget->Desc, ImGuiDrawData.ContentHash, bOverlayUpToDate);
+		if (bOverlayUpToDate)
+		{
+			FImGuiOverlayCache::AddCompositePass(GraphBuilder, FeatureLevel, Overlay, RenderTarget);
+			INC_DWORD_STAT(STAT_ImGuiOverlayComposites);
+			return;
+		}
+	}
+	else
+	{
+		ImGuiOverlayCache.Reset();
+	}
+	FRDGTextureRef DrawTarget = Overlay != nullptr ? Overlay : RenderTarget;
+	
+	//Grab persistent Vertex/Index Buffers large enough for this frame.
+	//They're filled while setting up the graph, so the pass itself only records draws.
+	//A frame identical to the previous one draws from the buffers that one filled.
+	FRHICommandListImmediate& RHICmdList = GraphBuilder.RHICmdList;
+	const uint32 VertexBufferSize = ImGuiDrawData.VtxBuffer.Num() * sizeof(ImDrawVert);
+	const uint32 AuxVertexBufferSize = ImGuiDrawData.VtxAuxBuffer.Num() * sizeof(FUnrealImGuiVertexAux);
+	const uint32 IndexBufferSize = ImGuiDrawData.IdxBuffer.Num() * sizeof(ImDrawIdx);
+	const uint32 PrimitiveBufferSize = ImGuiDrawData.Primitives.Num() * sizeof(FUnrealImGuiPrimitive);
+	UnrealImGui::FImGuiBufferRing::FSlot* UploadedBuffers = ImGuiBufferRing.FindUploaded(ImGuiDrawData.ContentHash);
+	UnrealImGui::FImGuiBufferRing::FSlot& GeometrySlot = UploadedBuffers != nullptr ? *UploadedBuffers : ImGuiBufferRing.Acquire(VertexBufferSize, IndexBufferSize, AuxVertexBufferSize, PrimitiveBufferSize);
+	FRHIBuffer* VertexBuffer = GeometrySlot.VertexBuffer.BufferRHI;
+	FRHIBuffer* AuxVertexBuffer = GeometrySlot.AuxVertexBuffer.BufferRHI;
+	FRHIBuffer* IndexBuffer = GeometrySlot.IndexBuffer.BufferRHI;
+	FRHIBuffer* PrimitiveInstanceBuffer = GeometrySlot.PrimitiveBuffer.BufferRHI;
+
+	if (UploadedBuffers == nullptr)
+	{
+		//A frame can hold nothing but GPU primitives.
+		//Packed vertices are written straight into the buffer, which stays large enough for the unpacked ones we fall back to.
+		uint32 VertexBytesUploaded = VertexBufferSize;
+		bool bPackedVertices = false;
+		if (VertexBufferSize > 0 && UsePackedVertices())
+		{
+			const uint32 PackedVertexBufferSize = ImGuiDrawData.VtxBuffer.Num() * sizeof(FUnrealImGuiPackedVertex);
+			void* VtxDst = RHICmdList.LockBuffer(VertexBuffer, 0, PackedVertexBufferSize, RLM_WriteOnly);
+			bPackedVertices = PackVertices(ImGuiDrawData.VtxBuffer.GetData(), ImGuiDrawData.VtxBuffer.Num(), ImGuiDrawData.DisplayPos, static_cast<FUnrealImGuiPackedVertex*>(VtxDst));
+			RHICmdList.UnlockBuffer(VertexBuffer);
+			if (bPackedVertices)
+			{
+				VertexBytesUploaded = PackedVertexBufferSize;
+				INC_DWORD_STAT_BY(STAT_ImGuiPackedVertexBytesSaved, VertexBufferSize - PackedVertexBufferSize);
+			}
+		}
+
+		if (VertexBufferSize > 0 && !bPackedVertices)
+		{
+			void* VtxDst = RHICmdList.LockBuffer(VertexBuffer, 0, VertexBufferSize, RLM_WriteOnly);
+			FMemory::Memcpy(VtxDst, ImGuiDrawData.VtxBuffer.GetData(), VertexBufferSize);
+			RHICmdList.UnlockBuffer(VertexBuffer);
+		}
+
+		if (AuxVertexBufferSize > 0)
+		{
+			void* VtxAuxDst = RHICmdList.LockBuffer(AuxVertexBuffer, 0, AuxVertexBufferSize, RLM_WriteOnly);
+			FMemory::Memcpy(VtxAuxDst, ImGuiDrawData.VtxAuxBuffer.GetData(), AuxVertexBufferSize);
+			RHICmdList.UnlockBuffer(AuxVertexBuffer);
+		}
+
+		if (IndexBufferSize > 0)
+		{
+			void* IdxDst = RHICmdList.LockBuffer(IndexBuffer, 0, IndexBufferSize, RLM_WriteOnly);
+			FMemory::Memcpy(IdxDst, ImGuiDrawData.IdxBuffer.GetData(), IndexBufferSize);
+			RHICmdList.UnlockBuffer(IndexBuffer);
+		}
+
+		if (PrimitiveBufferSize > 0)
+		{
+			void* PrimitiveDst = RHICmdList.LockBuffer(PrimitiveInstanceBuffer, 0, PrimitiveBufferSize, RLM_WriteOnly);
+			FMemory::Memcpy(PrimitiveDst, ImGuiDrawData.Primitives.GetData(), PrimitiveBufferSize);
+			RHICmdList.UnlockBuffer(PrimitiveInstanceBuffer);
+		}
+
+		INC_DWORD_STAT_BY(STAT_ImGuiBytesUploaded, VertexBytesUploaded + AuxVertexBufferSize + IndexBufferSize + PrimitiveBufferSize);
+		GeometrySlot.ContentHash = ImGuiDrawData.ContentHash;
+		GeometrySlot.bPackedVertices = bPackedVertices;
+	}
+
+	//The passes below capture the slot's buffers by value, the ring may reallocate its slots before they execute
+	const UnrealImGui::FImGuiBufferRing::FSlotRef GeometryBuffers = ImGuiBufferRing.MakeRef(GeometrySlot);
+
+	//Setup projection matrix	
+	const float L = ImGuiDrawData.DisplayPos.x;
+	const float R = ImGuiDrawData.DisplayPos.x + ImGuiDrawData.DisplaySize.x;
+	const float T = ImGuiDrawData.DisplayPos.y;
+	const float B = ImGuiDrawData.DisplayPos.y + ImGuiDrawData.DisplaySize.y;
+
+	const FMatrix44f OrthographicProjection(
+		FPlane4f(2.0f/(R-L),   0.0f,           0.0f,       0.0f),
+		FPlane4f(0.0f,         2.0f/(T-B),     0.0f,       0.0f),
+		FPlane4f(0.0f,         0.0f,           0.5f,       0.0f),
+		FPlane4f((R+L)/(L-R),  (T+B)/(B-T),    0.5f,       1.0f)
+	);
+
+	//Shared by every draw (and every pass) this frame
+	FImGuiUniformParameters UniformParameters;
+	UniformParameters.ProjectionMatrix = OrthographicProjection.GetTransposed();
+	UniformParameters.ImageSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+	UniformParameters.PackedVertexOrigin = FVector2f(ImGuiDrawData.DisplayPos.x, ImGuiDrawData.DisplayPos.y);
+	const TUniformBufferRef<FImGuiUniformParameters> UniformBuffer = TUniformBufferRef<FImGuiUniformParameters>::CreateUniformBufferImmediate(UniformParameters, UniformBuffer_SingleFrame);
+
+	//Large frames are split into several passes so RDG can record them in parallel on task graph workers.
+	//They target the same texture back to back, so RDG merges them into a single render pass and submits them in order.
+	//User callbacks expect to run on the render thread, so frames that have any are always recorded serially.
+	const int32 NumCmds = ImGuiDrawData.CmdBuffer.Num();
+	int32 NumPasses = 1;
+	if (GParallelRecordingThreshold > 0 && NumCmds >= GParallelRecordingThreshold && GRHISupportsParallelRHIExecute
+		&& !ImGuiDrawData.CmdBuffer.ContainsByPredicate([](const FUnrealImGuiDrawCmd& Cmd) { return Cmd.UserCallback != nullptr && Cmd.UserCallback != PrimitiveBatchCallback; }))
+	{
+		NumPasses = FMath::Min(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, FMath::DivideAndRoundUp(NumCmds, MinParallelCommandsPerPass));
+	}
+	const int32 CmdsPerPass = FMath::DivideAndRoundUp(NumCmds, NumPasses);
+	const EImGuiBlendMode AlphaBlendMode = Overlay != nullptr ? EImGuiBlendMode::Overlay : EImGuiBlendMode::AlphaBlend;
+
+	//Shader clipping mode: the frame's clip rects, fetched by the vertex shader. Small enough to upload every frame, reused or not.
+	FRDGBufferSRVRef ClipRects = nullptr;
+	if (ImGuiDrawData.bShaderClip && ImGuiDrawData.ClipRects.Num() > 0)
+	{
+		FRDGBufferRef ClipRectBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("ImGuiClipRects"), sizeof(FVector4f), ImGuiDrawData.ClipRects.Num(),
+			ImGuiDrawData.ClipRects.GetData(), ImGuiDrawData.ClipRects.Num() * sizeof(FVector4f), ERDGInitialDataFlags::NoCopy);
+		ClipRects = GraphBuilder.CreateSRV(ClipRectBuffer);
+	}
+
+	for (int32 FirstCmdIndex = 0; FirstCmdIndex < NumCmds; FirstCmdIndex += CmdsPerPass)
+	{
+		const int32 EndCmdIndex = FMath::Min(FirstCmdIndex + CmdsPerPass, NumCmds);
+
+		//Declare what the pass touches: it loads and writes the viewport target (or clears the overlay), and samples the font atlas (written by the glyph upload pass)
+		FImGuiPassParameters* PassParameters = GraphBuilder.AllocParameters<FImGuiPassParameters>();
+		const bool bClear = Overlay != nullptr && FirstCmdIndex == 0;
+		PassParameters->RenderTargets[0] = FRenderTargetBinding(DrawTarget, bClear ? ERenderTargetLoadAction::EClear : ERenderTargetLoadAction::ELoad);
+		PassParameters->FontAtlas = FontAtlas;
+		PassParameters->ClipRects = ClipRects;
+
+		//The draw data stays alive until the graph has executed, see Render_GameThread
+		GraphBuilder.AddPass(
+			RDG_EVENT_NAME("UnrealImGui %d-%d", FirstCmdIndex, EndCmdIndex),
+			PassParameters,
+			ERDGPassFlags::Raster,
+			[&ImGuiDrawData, GeometryBuffers, UniformBuffer, FeatureLevel, DrawTarget, AlphaBlendMode, ClipRects, FirstCmdIndex, EndCmdIndex](FRHICommandList& RHICmdList)
+		{
+			FRHIShaderResourceView* ClipRectsSRV = ClipRects != nullptr ? ClipRects->GetRHI() : nullptr;
+			RecordDraws_RenderThread(RHICmdList, FeatureLevel, ImGuiDrawData, DrawTarget->GetRHI(), UniformBuffer, GeometryBuffers, AlphaBlendMode, ClipRectsSRV, FirstCmdIndex, EndCmdIndex);
+		});
+	}
+
+	if (Overlay != nullptr)
+	{
+		FImGuiOverlayCache::AddCompositePass(GraphBuilder, FeatureLevel, Overlay, RenderTarget);
+	}
+
+	//Fence the ring slot once the draws reading it are on the GPU
+	GraphBuilder.AddPass(
+		RDG_EVENT_NAME("ImGuiReleaseBuffers"),
+		ERDGPassFlags::NeverCull,
+		[GeometryBuffers](FRHICommandListImmediate& RHICmdList)
+	{
+		ImGuiBufferRing.Release(RHICmdList, GeometryBuffers);
+	});
 }
 
 void UnrealImGui::Shutdown(UGameViewportClient* InGameViewportClient)
 {
+	DebugDrawQueue.SetEnabled(false);
+	GlyphCache.Shutdown();
 	ImGui::DestroyContext();
 	ImGuiContextPtr = nullptr;
 	OwningGameViewportClient.Reset();
+	TextureRegistry.Reset();
 
 	if (BeginFrameDelegate.IsValid())
 	{
@@ -462,8 +1654,9 @@ void UnrealImGui::Shutdown(UGameViewportClient* InGameViewportClient)
 		}
 	}
 
+	//Snapshots may still be referenced by queued render commands, so let the render thread free them once it gets here
 	ENQUEUE_RENDER_COMMAND(ShutdownImGuiCmd)(
-        [](FRHICommandListImmediate& /*RHICmdList*/)
+        [ReleasedDrawDataPool = MoveTemp(DrawDataPool)](FRHICommandListImmediate& /*RHICmdList*/)
         {
             Shutdown_RenderThread();
         }
@@ -472,15 +1665,11 @@ void UnrealImGui::Shutdown(UGameViewportClient* InGameViewportClient)
 
 void UnrealImGui::Shutdown_RenderThread()
 {
-	if (ImguiVertexBuffer.IsValid())
-	{
-		ImguiVertexBuffer = nullptr;
-	}
-	
-	if (ImguiIndexBuffer.IsValid())
-	{
-		ImguiIndexBuffer = nullptr;
-	}
+	//The snapshot goes away with the pool
+	LastDrawData = nullptr;
+	ImGuiOverlayCache.Reset();
+	ImGuiBufferRing.Reset();
+	UnrealImGui::ResetPipelineCache();
 	
 	if (ImGuiFontTexture.IsValid())
 	{
@@ -73,7 +73,11 @@ class UImGuiFunctionLibrary : public UBlueprintFunctionLibrary
 
 	//TODO: SmallButton, ArrowButton
 
-	//TODO: Image, ImageButton (make work w/ UE4 Textures?)
+	/// Draws a texture. Set bIgnoreAlpha for textures whose alpha channel isn't opacity (i.e. GBuffer render targets)
+	UFUNCTION(BlueprintCallable, Category = ImGui)
+	static void ImguiImage(UTexture* Texture, FVector2D Size, bool bIgnoreAlpha = false);
+
+	//TODO: ImageButton
 	
 	UFUNCTION(BlueprintCallable, Category = ImGui)
     static bool ImguiCheckbox(const FString& Label, UPARAM(ref) bool& BoolRef);
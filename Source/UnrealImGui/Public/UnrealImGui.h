@@ -3,9 +3,13 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/StringView.h"
 #include "../../RenderCore/Public/ShaderParameters.h"
 #include "../../RHI/Public/RHIResources.h"
 #include "Runtime/RenderCore/Public/GlobalShader.h"
+#include "ShaderPermutation.h"
+#include "ShaderParameterStruct.h"
+#include "RenderGraphFwd.h"
 
 #define UNREAL_IMGUI_API DLLEXPORT
 #define IMGUI_API DLLEXPORT
@@ -19,100 +23,315 @@ public:
 
 DECLARE_LOG_CATEGORY_EXTERN(LogUnrealImGui, Verbose, All);
 
+namespace UnrealImGui
+{
+	//Number of textures bound at once in multi-texture mode (keep in sync with ImGui.usf). Slot 0 is always the font atlas.
+	static constexpr uint32 MaxBoundTextures = 8;
+
+	//Number of clip rects a frame can reference in shader clipping mode (FUnrealImGuiVertexAux::ClipRectIndex is 16-bit)
+	static constexpr uint32 MaxShaderClipRects = 65536;
+
+	//Packed vertex mode: subpixel steps of FUnrealImGuiPackedVertex::Pos (keep in sync with ImGui.usf). Positions reach 4096 pixels either side of DisplayPos.
+	static constexpr float PackedPositionScale = 8.0f;
+
+	//Shader clipping mode reads a StructuredBuffer in the vertex shader, which not every mobile (ES3.1) platform supports
+	inline bool SupportsShaderClip(EShaderPlatform Platform) { return IsFeatureLevelSupported(Platform, ERHIFeatureLevel::SM5); }
+	inline bool SupportsShaderClip(ERHIFeatureLevel::Type FeatureLevel) { return FeatureLevel >= ERHIFeatureLevel::SM5; }
+}
+
+//Multi-texture mode: several textures are bound at once and selected per vertex, so draws using different textures can be merged
+class FImGuiMultiTextureDim : SHADER_PERMUTATION_BOOL("IMGUI_MULTI_TEXTURE");
+
+//Font atlas is a single channel coverage texture (PF_G8), expanded to white + alpha when sampled
+class FImGuiAlpha8FontDim : SHADER_PERMUTATION_BOOL("IMGUI_ALPHA8_FONT");
+
+//Font atlas is a single channel texture (PF_G8) holding signed distance fields (ImFontAtlasFlags_SignedDistanceField), resolved to coverage when sampled.
+//Never combined with FImGuiAlpha8FontDim, which only describes coverage atlases.
+class FImGuiSdfFontDim : SHADER_PERMUTATION_BOOL("IMGUI_SDF_FONT");
+
+//Packed vertex mode: vertices are uploaded as FUnrealImGuiPackedVertex instead of ImDrawVert
+class FImGuiPackedVertexDim : SHADER_PERMUTATION_BOOL("IMGUI_PACKED_VERTEX");
+
+//Analytic anti-aliasing: strokes emitted with ImDrawListFlags_AntiAliasedLinesAnalytic get their coverage resolved from their UVs, only applies where the font atlas is sampled
+class FImGuiAnalyticAADim : SHADER_PERMUTATION_BOOL("IMGUI_ANALYTIC_AA");
+
+//Shader clipping mode: clip rects are fetched per vertex and applied in the pixel shader instead of with scissor rects, so draws using different clip rects can be merged
+class FImGuiShaderClipDim : SHADER_PERMUTATION_BOOL("IMGUI_SHADER_CLIP");
+
+//Parameters shared by every ImGui draw in a frame, created once per frame and bound with a single uniform buffer
+BEGIN_GLOBAL_SHADER_PARAMETER_STRUCT(FImGuiUniformParameters, )
+	SHADER_PARAMETER(FMatrix44f, ProjectionMatrix)
+	SHADER_PARAMETER_SAMPLER(SamplerState, ImageSampler)	//Multi-texture mode: sampler for every slot but the font atlas
+	SHADER_PARAMETER(FVector2f, PackedVertexOrigin)			//Packed vertex mode: what packed positions are relative to (DisplayPos)
+END_GLOBAL_SHADER_PARAMETER_STRUCT()
+
 //Vertex Shader for ImGui
 class FImGuiVS : public FGlobalShader
 {
-    DECLARE_SHADER_TYPE(FImGuiVS, Global);
-
-    FImGuiVS() { }
-    FImGuiVS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
-    : FGlobalShader(Initializer)
-    {
-    	ImGuiProjectionMatrix.Bind(Initializer.ParameterMap, TEXT("ImGuiProjectionMatrix"), SPF_Mandatory);
-    }
-
-    static bool ShouldCache(EShaderPlatform Platform)
-    {
-        return true;
-    }
-
-    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
-    {
-        return true;
-    }
-
-	void SetProjectionMatrix(FRHICommandList& RHICmdList, const FMatrix44f& InMatrix, const ERHIFeatureLevel::Type FeatureLevel) const
-    {
-    	const auto GlobalShaderMap = GetGlobalShaderMap(FeatureLevel);
-    	const TShaderMapRef<FImGuiVS> VertexShader(GlobalShaderMap); //FCS FIXME: Shouldn't need to do this
-    	SetShaderValue(RHICmdList, VertexShader.GetVertexShader(), ImGuiProjectionMatrix, InMatrix);
-    }
-
-private:
-
-	LAYOUT_FIELD(FShaderParameter, ImGuiProjectionMatrix);
+	DECLARE_SHADER_TYPE(FImGuiVS, Global);
+	SHADER_USE_PARAMETER_STRUCT(FImGuiVS, FGlobalShader);
+
+	using FPermutationDomain = TShaderPermutationDomain<FImGuiMultiTextureDim, FImGuiShaderClipDim, FImGuiPackedVertexDim>;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_REF(FImGuiUniformParameters, ImGuiUniforms)
+		SHADER_PARAMETER_SRV(StructuredBuffer<float4>, ImGuiClipRects)	//Shader clipping permutation only, see FUnrealImGuiDrawData::ClipRects
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		return !PermutationVector.Get<FImGuiShaderClipDim>() || UnrealImGui::SupportsShaderClip(Parameters.Platform);
+	}
 };
 
 //Pixel Shader for ImGui
 class FImGuiPS : public FGlobalShader
 {
 	DECLARE_SHADER_TYPE(FImGuiPS, Global);
+	SHADER_USE_PARAMETER_STRUCT(FImGuiPS, FGlobalShader);
+
+	using FPermutationDomain = TShaderPermutationDomain<FImGuiMultiTextureDim, FImGuiAlpha8FontDim, FImGuiSdfFontDim, FImGuiShaderClipDim, FImGuiAnalyticAADim>;
 
-	FImGuiPS() { }
-	FImGuiPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
-     : FGlobalShader(Initializer)
+	//Only the texture bindings change between draws, the rest comes from the frame's uniform buffer
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_STRUCT_REF(FImGuiUniformParameters, ImGuiUniforms)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture)		//Font atlas in multi-texture mode
+		SHADER_PARAMETER_SAMPLER(SamplerState, ImGuiSampler)
+		//Multi-texture permutation only, keep in sync with UnrealImGui::MaxBoundTextures
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture1)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture2)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture3)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture4)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture5)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture6)
+		SHADER_PARAMETER_TEXTURE(Texture2D, ImGuiTexture7)
+		SHADER_PARAMETER(uint32, ImGuiOpaqueSlotMask)	//Slots whose alpha channel should be ignored
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
-		ImGuiFontTexture.Bind(Initializer.ParameterMap, TEXT("ImGuiFontTexture"), SPF_Mandatory);
-		ImGuiFontSampler.Bind(Initializer.ParameterMap, TEXT("ImGuiFontSampler"), SPF_Mandatory);
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		if (PermutationVector.Get<FImGuiAlpha8FontDim>() && PermutationVector.Get<FImGuiSdfFontDim>())
+		{
+			return false;
+		}
+		//Never bound without the matching vertex shader
+		return !PermutationVector.Get<FImGuiShaderClipDim>() || UnrealImGui::SupportsShaderClip(Parameters.Platform);
 	}
+};
+
+class FTextureResource;
+class UTexture;
 
-	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+namespace UnrealImGui
+{
+	class FImGuiTextureRegistry;
+	class FImGuiPrimitiveBuffer;
+
+	//Texture referenced by a frame's draw commands, resolved from its ImTextureID on the game thread
+	struct FUnrealImGuiTexture
 	{
-		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
-		// Add your own defines for the shader code
-		OutEnvironment.SetDefine(TEXT("MY_DEFINE"), 1);
-	}
+		FTextureResource* Resource = nullptr;   // Set for registered UTextures, read TextureRHI from it on the render thread
+		FTextureRHIRef    TextureRHI;           // Set for registered RHI textures
+		bool              bFontAtlas = false;   // ImGui's font atlas (ImTextureID 0)
+		bool              bIgnoreAlpha = false; // Draw opaquely, for textures whose alpha channel isn't meant as opacity
 
-	static bool ShouldCache(EShaderPlatform Platform)
+		bool operator==(const FUnrealImGuiTexture& Other) const
+		{
+			return Resource == Other.Resource && TextureRHI == Other.TextureRHI && bFontAtlas == Other.bFontAtlas && bIgnoreAlpha == Other.bIgnoreAlpha;
+		}
+	};
+
+	//Multi-texture mode: textures bound together for a single draw
+	struct FUnrealImGuiTextureSet
 	{
-		return true;
-	}
+		uint32 TextureIndices[MaxBoundTextures];    // Indices into FUnrealImGuiDrawData::Textures, slot 0 is always the font atlas
+		uint32 NumTextures = 0;
 
-	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+		int32 FindSlot(uint32 TextureIndex) const
+		{
+			for (uint32 Slot = 0; Slot < NumTextures; ++Slot)
+			{
+				if (TextureIndices[Slot] == TextureIndex)
+				{
+					return Slot;
+				}
+			}
+			return INDEX_NONE;
+		}
+
+		bool CanAdd(uint32 TextureIndex) const
+		{
+			return NumTextures < MaxBoundTextures || FindSlot(TextureIndex) != INDEX_NONE;
+		}
+
+		void Add(uint32 TextureIndex)
+		{
+			if (FindSlot(TextureIndex) == INDEX_NONE)
+			{
+				check(NumTextures < MaxBoundTextures);
+				TextureIndices[NumTextures++] = TextureIndex;
+			}
+		}
+	};
+
+	//Multi-texture and shader clipping modes: second vertex stream, selecting which bound texture a vertex samples and which clip rect applies to it.
+	//Read as a single VET_UByte4 attribute (keep in sync with ImGui.usf)
+	struct FUnrealImGuiVertexAux
 	{
-		return true;
-	}
+		uint8 TextureSlot;
+		uint8 Padding;
+		uint16 ClipRectIndex;   // Index into FUnrealImGuiDrawData::ClipRects
+	};
 
-	void SetFontTexture(FRHICommandList& RHICmdList, const FTexture2DRHIRef& InTexture2D, const FSamplerStateRHIRef& InSamplerState, const ERHIFeatureLevel::Type FeatureLevel) const
+	//Packed vertex mode: ImDrawVert in 12 bytes instead of 20, written straight into the GPU vertex buffer (keep in sync with ImGui.usf)
+	struct FUnrealImGuiPackedVertex
 	{
-		const auto GlobalShaderMap = GetGlobalShaderMap(FeatureLevel);
-		const TShaderMapRef<FImGuiPS> PixelShader(GlobalShaderMap); //FCS FIXME: Shouldn't need to do this
-		SetTextureParameter(RHICmdList, PixelShader.GetPixelShader(), ImGuiFontTexture, ImGuiFontSampler, InSamplerState, InTexture2D);
-	}
+		int16  Pos[2];  // Relative to DisplayPos, in 1/PackedPositionScale pixels
+		int16  UV[2];   // Snorm16, so only UVs within [-1, 1] can be packed (analytic anti-aliasing puts negative values there)
+		ImU32  Col;
+	};
 
-private:
+	enum class EImGuiPrimitiveType : uint32
+	{
+		Line,			//Segment from P0 to P1 with round caps (keep in sync with ImGuiPrimitives.usf)
+		Circle,			//Ring centered on P0
+		CircleFilled,	//Disc centered on P0
+	};
 
-	LAYOUT_FIELD(FShaderResourceParameter, ImGuiFontTexture);
-	LAYOUT_FIELD(FShaderResourceParameter, ImGuiFontSampler);
-};
+	//GPU primitive path: one instance, expanded to a quad in the vertex shader and shaded analytically
+	struct FUnrealImGuiPrimitive
+	{
+		ImVec2              P0;
+		ImVec2              P1;
+		float               Radius;
+		float               Thickness;
+		ImU32               Col;
+		EImGuiPrimitiveType Type;
+	};
 
-namespace UnrealImGui
-{
+	//Flattened ImDrawCmd
+	struct FUnrealImGuiDrawCmd
+	{
+		ImVec4          ClipRect;               // Clipping rectangle (x1, y1, x2, y2), in ImGui coordinates
+		uint32          TextureIndex;           // Index into FUnrealImGuiDrawData::Textures (or FUnrealImGuiDrawData::TextureSets in multi-texture mode)
+		uint32          VtxOffset;              // Start offset in FUnrealImGuiDrawData::VtxBuffer
+		uint32          IdxOffset;              // Start offset in FUnrealImGuiDrawData::IdxBuffer
+		uint32          ElemCount;              // Number of indices (multiple of 3) to be rendered as triangles
+		ImDrawCallback  UserCallback;           // If != NULL, call the function instead of rendering the vertices. PrimitiveBatchCallback draws ElemCount primitives from VtxOffset in FUnrealImGuiDrawData::Primitives
+		void*           UserCallbackData;       // The draw callback code can access this
+		const ImDrawList* CallbackDrawList;     // User callbacks: copy of the owning draw list, passed as their parent_list
+		const ImDrawCmd*  CallbackCmd;          // User callbacks: the command within CallbackDrawList, passed as their cmd
+	};
+
+	//Flattened copy of ImDrawData, owned by the render thread while a frame is in flight.
+	//All draw lists are appended into single vertex/index/command arrays, with each command's offsets rebased onto them.
 	struct FUnrealImGuiDrawData
 	{
-		TArray<ImDrawList> CmdLists; 			// CmdList Array (explicitly copied into a tarray so we can pass to the Render Thread)
-		int             TotalIdxCount;          // For convenience, sum of all ImDrawList's IdxBuffer.Size
-		int             TotalVtxCount;          // For convenience, sum of all ImDrawList's VtxBuffer.Size
-		ImVec2          DisplayPos;             // Upper-left position of the viewport to render (== upper-left of the orthogonal projection matrix to use)
-		ImVec2          DisplaySize;            // Size of the viewport to render (== io.DisplaySize for the main viewport) (DisplayPos + DisplaySize == lower-right of the orthogonal projection matrix to use)
-		ImVec2          FramebufferScale;       // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
+		TArray<ImDrawVert>          VtxBuffer;  // Vertices of every ImDrawList, back to back
+		TArray<ImDrawIdx>           IdxBuffer;  // Indices of every ImDrawList, regrouped by draw command (relative to each command's VtxOffset)
+		TArray<FUnrealImGuiDrawCmd> CmdBuffer;  // Commands of every ImDrawList
+		TArray<FUnrealImGuiTexture> Textures;   // Unique textures referenced by CmdBuffer
+		TArray<FUnrealImGuiTextureSet> TextureSets;     // Multi-texture mode: texture slots bound for each command
+		TArray<FUnrealImGuiVertexAux>  VtxAuxBuffer;    // Multi-texture and shader clipping modes: per vertex texture slot and clip rect, parallel to VtxBuffer
+		TArray<FVector4f>              ClipRects;       // Shader clipping mode: clip rects in framebuffer pixels (x1, y1, x2, y2), truncated like scissor rects
+		TArray<FUnrealImGuiPrimitive>  Primitives;      // GPU primitives of every ImDrawList, referenced by PrimitiveBatchCallback commands
+		bool                        bMultiTexture = false;
+		bool                        bShaderClip = false;
+		bool                        bAnalyticAA = false;    // Some draw list was built with ImDrawListFlags_AntiAliasedLinesAnalytic
+		ImVec2                      DisplayPos;          // Upper-left position of the viewport to render (== upper-left of the orthogonal projection matrix to use)
+		ImVec2                      DisplaySize;         // Size of the viewport to render (== io.DisplaySize for the main viewport) (DisplayPos + DisplaySize == lower-right of the orthogonal projection matrix to use)
+		ImVec2                      FramebufferScale;    // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
+		uint64                      ContentHash = 0;     // Hash of the ImGui output this was copied from, identical frames have the same hash. 0 if unknown.
+
+		//Copies ImGui's draw data, reusing our existing allocations.
+		//Commands of a draw list that share a texture and clip rect are merged when they can be reordered without changing the result.
+		//In multi-texture mode, commands only need to share a clip rect, as long as the merged command uses at most MaxBoundTextures textures.
+		//In shader clipping mode, commands don't need to share a clip rect, and a merged command's ClipRect is the union of the ones it holds.
+		//Shader clipping is turned off for frames with more commands than MaxShaderClipRects.
+		void CopyFrom(const ImDrawData& DrawData, const FImGuiTextureRegistry& TextureRegistry, const FImGuiPrimitiveBuffer& PrimitiveBuffer, bool bInMultiTexture, bool bInShaderClip);
+
+	private:
+		//Copies of the draw lists that have user callbacks, which run on the render thread and may read their parent_list.
+		//Only the first NumCallbackDrawLists are used by this frame, the rest keep their allocations for the next ones.
+		TArray<TUniquePtr<ImDrawList>> CallbackDrawLists;
+		int32 NumCallbackDrawLists = 0;
+
+		//Scratch space for CopyFrom, kept around so it doesn't allocate
+		struct FPendingBatch
+		{
+			FUnrealImGuiDrawCmd Cmd;
+			FUnrealImGuiTextureSet TextureSet;
+			int32 FirstRange;
+			int32 LastRange;
+		};
+		struct FIndexRange
+		{
+			uint32 IdxOffset;
+			uint32 ElemCount;
+			uint32 TextureIndex;
+			uint32 ClipRectIndex;
+			int32  NextRange;
+		};
+		TArray<FPendingBatch> PendingBatches;
+		TArray<FIndexRange>   PendingRanges;
+
+		uint32 AddTexture(const FUnrealImGuiTexture& Texture);
+		uint32 AddClipRect(const ImVec4& ClipRect);
+		void FlushPendingBatches(const ImDrawList& CmdList, uint32 ListVtxOffset);
+		const ImDrawList* AddCallbackDrawList(const ImDrawList& CmdList);
 	};
+
+	//ImDrawList::AddCallback(): callbacks run on the render thread while the frame is drawn, by which time ImGui is building the next one.
+	//Their parent_list is a copy of the draw list taken when the frame was handed to the render thread, cmd points into that copy.
+	//Don't touch the ImGui context from them. Frames with callbacks are always recorded on the render thread, and never replayed from the overlay cache.
 	
+	//Registers a texture so it can be drawn with ImGui::Image(). Returns the ImTextureID to pass to ImGui.
+	//bIgnoreAlpha draws the texture opaquely, which is usually what you want when previewing render targets.
+	//A texture registered again with the same bIgnoreAlpha returns the same ID. IDs stop drawing once unregistered, even if another texture reuses the slot.
+	//UTextures are unregistered automatically once garbage collected.
+	ImTextureID UNREAL_IMGUI_API RegisterTexture(UTexture* Texture, bool bIgnoreAlpha = false);
+	ImTextureID UNREAL_IMGUI_API RegisterTexture(FRHITexture* Texture, bool bIgnoreAlpha = false);
+	void UNREAL_IMGUI_API UnregisterTexture(ImTextureID TextureId);
+
+	//Draws lines and circles as GPU primitives: each one is a single instance expanded and anti-aliased by ImGuiPrimitives.usf,
+	//instead of being tessellated into ImDrawList vertices on the game thread. Meant for overlays pushing huge numbers of them (telemetry, plots).
+	//Falls back to the matching ImDrawList function when imgui.gpuprimitives is 0 or there is no GPU to draw with (NullRHI),
+	//so the same code renders everywhere. Lines get round caps, and polyline joints are the overlapping caps.
+	void UNREAL_IMGUI_API AddLine(ImDrawList* DrawList, const ImVec2& P0, const ImVec2& P1, ImU32 Col, float Thickness = 1.0f);
+	void UNREAL_IMGUI_API AddPolyline(ImDrawList* DrawList, const ImVec2* Points, int32 NumPoints, ImU32 Col, bool bClosed, float Thickness = 1.0f);
+	void UNREAL_IMGUI_API AddCircle(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Col, float Thickness = 1.0f);
+	void UNREAL_IMGUI_API AddCircleFilled(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Col);
+
+	//Draw list the DebugDraw functions draw into
+	enum class EImGuiDebugDrawLayer : uint8
+	{
+		Background,		//ImGui::GetBackgroundDrawList(), behind every window
+		Foreground,		//ImGui::GetForegroundDrawList(), over every window
+	};
+
+	//Debug drawing for any thread, e.g. parallel actor ticks or async tasks, which must never call ImGui:: functions themselves.
+	//Each thread queues primitives into a buffer of its own without locking, and the next Render_GameThread draws everything queued once.
+	//Positions are in viewport pixels, except for the World functions, which project through the first local player's view (and draw nothing without one).
+	//Primitives are dropped while ImGui isn't initialized, and once a thread has imgui.debugdraw.maxpendingkb waiting.
+	void UNREAL_IMGUI_API DebugDrawLine(const FVector2D& P0, const FVector2D& P1, FColor Color, float Thickness = 1.0f, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawRect(const FVector2D& Min, const FVector2D& Max, FColor Color, float Thickness = 1.0f, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawRectFilled(const FVector2D& Min, const FVector2D& Max, FColor Color, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawCircle(const FVector2D& Center, float Radius, FColor Color, float Thickness = 1.0f, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawCircleFilled(const FVector2D& Center, float Radius, FColor Color, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawText(const FVector2D& Position, FStringView Text, FColor Color, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawWorldPoint(const FVector& Location, FColor Color, float Size = 4.0f, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawWorldLine(const FVector& Start, const FVector& End, FColor Color, float Thickness = 1.0f, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+	void UNREAL_IMGUI_API DebugDrawWorldText(const FVector& Location, FStringView Text, FColor Color, EImGuiDebugDrawLayer Layer = EImGuiDebugDrawLayer::Background);
+
 	void UNREAL_IMGUI_API Initialize(UGameViewportClient* InGameViewportClient);
-	void Initialize_RenderThread(FRHICommandListImmediate& RHICmdList, const TArray<unsigned char>& FontTextureData, int32 Width, int32 Height);
+	void Initialize_RenderThread(FRHICommandListImmediate& RHICmdList, const TArray<unsigned char>& FontTextureData, EPixelFormat FontTextureFormat, int32 Width, int32 Height, bool bSdfFontAtlas);
 	
 	void Render_GameThread(const FViewport* const Viewport);
-	void Render_RenderThread(FRHICommandListImmediate& RHICmdList, ERHIFeatureLevel::Type FeatureLevel, const FUnrealImGuiDrawData& ImGuiDrawData, const FTexture2DRHIRef& RenderTargetTexture);
+	//Adds the ImGui pass to GraphBuilder. It draws over RenderTarget and samples FontAtlas (nullptr if there isn't one yet).
+	//ImGuiDrawData must stay alive until the graph has executed.
+	void Render_RenderThread(FRDGBuilder& GraphBuilder, ERHIFeatureLevel::Type FeatureLevel, const FUnrealImGuiDrawData& ImGuiDrawData, FRDGTextureRef RenderTarget, FRDGTextureRef FontAtlas);
 
 	void UNREAL_IMGUI_API Shutdown(UGameViewportClient* InGameViewportClient);
 	void Shutdown_RenderThread();
@@ -1,5 +1,6 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class UnrealImGui : ModuleRules
@@ -45,6 +46,27 @@ public class UnrealImGui : ModuleRules
 			);
 		
 		
+		//Set to true to compile in ImGui's FreeType rasterizer (misc/freetype), which supports hinting. Selected at runtime with imgui.font.freetype
+		bool bWithFreeType = false;
+		if (bWithFreeType)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "FreeType2");
+			//imgui_freetype.cpp includes the ImGui headers relative to its own folder
+			PrivateIncludePaths.Add(Path.Combine(ModuleDirectory, "..", "ThirdParty", "ImGui"));
+		}
+		PrivateDefinitions.Add("WITH_IMGUI_FREETYPE=" + (bWithFreeType ? "1" : "0"));
+
+		//Set to true to make ImDrawIdx 32-bit, so a single draw command can address more than 64k vertices (large scatter plots, node graphs).
+		//Public, as it changes the layout of ImGui's draw data for every module including imgui.h
+		bool bImGui32BitIndices = false;
+		PublicDefinitions.Add("IMGUI_USE_32BIT_INDICES=" + (bImGui32BitIndices ? "1" : "0"));
+
+		//Set to false to tessellate polylines and convex fills with ImGui's scalar code instead of the SSE2/NEON normal kernels.
+		//Both produce bitwise identical vertices as long as the scalar code isn't contracted into FMAs (checked by UnrealImGui.SimdTessellation.MatchesScalar).
+		//Platforms without either instruction set always use the scalar code
+		bool bImGuiSimdTessellation = true;
+		PrivateDefinitions.Add("IMGUI_SIMD_TESSELLATION=" + (bImGuiSimdTessellation ? "1" : "0"));
+		
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{